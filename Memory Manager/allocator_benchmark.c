@@ -0,0 +1,196 @@
+#include "headers.h"
+#include "scheduler_utilities.h"
+#include <time.h>
+
+// test cases to replay
+#define TEST_CASES 5
+#define TEST_CASE_PATH "../Test Cases/Memory Manager Test Cases/processes%d.txt"
+
+// generated traces (same distribution as test_generator.c with denser arrivals)
+#define GENERATED_TRACES 2
+int generatedSizes[GENERATED_TRACES] = {1000, 20000};
+
+double getTime()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+struct process *readTrace(char *path, int *N)
+{
+	FILE *pFile = fopen(path, "r");
+	if (pFile == NULL)
+	{
+		return NULL;
+	}
+	*N = -1;
+	for (char c = getc(pFile); c != EOF; c = getc(pFile))
+	{
+		if (c == '\n')
+		{
+			*N += 1;
+		}
+	}
+	rewind(pFile);
+	struct process *processes = (struct process *) malloc(*N * sizeof(struct process));
+	fscanf(pFile, "%*[^\n]\n");
+	for (int i = 0; i < *N; i++)
+	{
+		fscanf(pFile, "%d\t%d\t%d\t%d\t%d\n", &processes[i].id, &processes[i].arrivalTime, &processes[i].runningTime, &processes[i].priority, &processes[i].memSize);
+	}
+	fclose(pFile);
+	return processes;
+}
+
+struct process *generateTrace(int N)
+{
+	struct process *processes = (struct process *) malloc(N * sizeof(struct process));
+	srand(N);
+	int arrivalTime = 1;
+	for (int i = 0; i < N; i++)
+	{
+		arrivalTime += rand() % 6;
+		processes[i].id = i + 1;
+		processes[i].arrivalTime = arrivalTime;
+		processes[i].runningTime = rand() % 30 + 1;
+		processes[i].priority = rand() % 11;
+		processes[i].memSize = rand() % 255 + 1;
+	}
+	return processes;
+}
+
+// replays a trace with one allocator: each process holds its memory for its running time
+// after it is admitted, and processes that do not fit wait in arrival order
+void replayTrace(char *name, struct process *processes, int N)
+{
+	for (allocatorType = 0; allocatorType < ALLOCATORS; allocatorType++)
+	{
+		initPool(&memUnitPool, 2 * MEMORY_UNITS);
+		struct memUnit *memory = (struct memUnit *) poolAllocate(&memUnitPool);
+		memory->id = EMPTY;
+		memory->size = MEMORY_SIZE;
+		memory->start = 0;
+		memory->largestFree = MEMORY_SIZE;
+		memory->parent = NULL;
+		memory->left = NULL;
+		memory->right = NULL;
+		initAllocator(memory);
+
+		int *finishTime = (int *) malloc(N * sizeof(int));
+		int *running = (int *) malloc(N * sizeof(int));
+		int *waiting = (int *) malloc(N * sizeof(int));
+		for (int i = 0; i < N; i++)
+		{
+			processes[i].allocationSize = allocationSizeFor(processes[i].memSize);
+			processes[i].allocatedMemUnit = NULL;
+		}
+
+		int arrived = 0;
+		int finished = 0;
+		int runningCount = 0;
+		int waitingCount = 0;
+		long waitingTime = 0;
+		long operations = 0;
+		double operationTime = 0;
+		long ticks = 0;
+		double internal = 0;
+		double external = 0;
+		double utilization = 0;
+		for (int currentTime = 0; finished < N; currentTime++)
+		{
+			while ((arrived < N) && (processes[arrived].arrivalTime <= currentTime))
+			{
+				waiting[waitingCount++] = arrived++;
+			}
+
+			// free the processes that finished
+			double start = getTime();
+			for (int i = runningCount - 1; i >= 0; i--)
+			{
+				if (finishTime[running[i]] <= currentTime)
+				{
+					deallocate(&processes[running[i]]);
+					running[i] = running[--runningCount];
+					finished++;
+					operations++;
+				}
+			}
+
+			// admit the waiting processes that fit in arrival order
+			int stillWaiting = 0;
+			for (int i = 0; i < waitingCount; i++)
+			{
+				struct process *p_process = &processes[waiting[i]];
+				bool processAllocated = false;
+				if (mayFit(memory, p_process->allocationSize))
+				{
+					processAllocated = allocate(memory, p_process);
+					if (!processAllocated && (p_process->allocatedMemUnit != NULL))
+					{
+						splitAllocate(p_process);
+						processAllocated = true;
+					}
+					operations++;
+				}
+				if (processAllocated)
+				{
+					finishTime[waiting[i]] = currentTime + p_process->runningTime;
+					running[runningCount++] = waiting[i];
+					waitingTime += currentTime - p_process->arrivalTime;
+				}
+				else
+				{
+					waiting[stillWaiting++] = waiting[i];
+				}
+			}
+			waitingCount = stillWaiting;
+			operationTime += getTime() - start;
+
+			// sample the memory
+			int free = MEMORY_SIZE - memoryCounters.allocatedBytes;
+			internal += memoryCounters.allocatedBytes - memoryCounters.requestedBytes;
+			external += (free == 0) ? 0 : 1 - (largestFreeSize(memory) / (double) free);
+			utilization += memoryCounters.allocatedBytes;
+			ticks++;
+		}
+
+		printf("%-14s %-10s %-12.2f %-12.2f %-12.2f %-12.2f %-10.1f\n", name, allocatorNames[allocatorType], waitingTime / (float) N, utilization / ticks / MEMORY_SIZE * 100, internal / ticks, external / ticks * 100, operationTime * 1e9 / operations);
+
+		free(finishTime);
+		free(running);
+		free(waiting);
+		free(memUnitPool.buffer);
+	}
+}
+
+int main(int argc, char * argv[])
+{
+	printf("%-14s %-10s %-12s %-12s %-12s %-12s %-10s\n", "trace", "allocator", "avg wait", "util %", "internal", "external %", "ns/op");
+	for (int t = 1; t <= TEST_CASES; t++)
+	{
+		char path[64];
+		char name[16];
+		int N;
+		sprintf(path, TEST_CASE_PATH, t);
+		sprintf(name, "processes%d", t);
+		struct process *processes = readTrace(path, &N);
+		if (processes == NULL)
+		{
+			printf("Could not open file %s\n", path);
+			continue;
+		}
+		replayTrace(name, processes, N);
+		free(processes);
+	}
+	for (int t = 0; t < GENERATED_TRACES; t++)
+	{
+		char name[16];
+		sprintf(name, "generated%d", generatedSizes[t]);
+		struct process *processes = generateTrace(generatedSizes[t]);
+		replayTrace(name, processes, generatedSizes[t]);
+		free(processes);
+	}
+	printf("(avg wait in time steps before admission, internal fragmentation in bytes)\n");
+	return 0;
+}
@@ -0,0 +1,677 @@
+// Contiguous memory allocators. The buddy system allocates power-of-two memory units from a
+// binary tree. The other allocators allocate variable-size blocks (rounded up to the smallest
+// allocation unit) from a list of blocks ordered by address, where each block is a memory
+// unit whose left and right links point to the previous and next blocks:
+// - first-fit, best-fit and next-fit scan the blocks for a free block that fits
+// - TLSF (two-level segregated fit) keeps the free blocks in size classes indexed by two
+//   bitmaps, so allocation and deallocation take constant time
+// The buddy system can also be combined with a slab layer: small processes are allocated
+// from buddy units of SLAB_SIZE bytes (slabs) divided into objects of one size class.
+#include <string.h>
+
+// maximum number of blocks (one per allocation unit)
+#define BLOCKS (MEMORY_SIZE / SMALLEST_ALLOCATION_UNIT)
+
+// TLSF classes: one first level class per power of two, split into TLSF_SL_COUNT second level classes
+#define TLSF_SL_LOG2 2
+#define TLSF_SL_COUNT (1 << TLSF_SL_LOG2)
+#define TLSF_FL_COUNT ALLOCATION_ORDERS
+
+struct blockList
+{
+	struct memUnit *memory;	// root memory unit holding the largest free block (not kept by TLSF)
+	struct memUnit *head;
+	struct memUnit *rover;	// next-fit search start
+
+	// TLSF free lists, linked by block index (start / SMALLEST_ALLOCATION_UNIT)
+	struct memUnit *classes[TLSF_FL_COUNT][TLSF_SL_COUNT];
+	unsigned int flBitmap;
+	unsigned int slBitmap[TLSF_FL_COUNT];
+	struct memUnit *nextFree[BLOCKS];
+	struct memUnit *prevFree[BLOCKS];
+};
+
+struct blockList blocks;
+
+// slab size (can be overridden with -D)
+#ifndef SLAB_SIZE
+#define SLAB_SIZE 128
+#endif
+#if (SLAB_SIZE / SMALLEST_ALLOCATION_UNIT) > 32
+#error "SLAB_SIZE must hold at most 32 objects of the smallest size class"
+#endif
+
+// slab size classes
+#define SLAB_CLASSES 6
+int slabClassSizes[SLAB_CLASSES] = {8, 16, 24, 32, 48, 64};
+
+// buddy memory unit id of slabs
+#define SLAB_PAGE -2
+
+struct slab
+{
+	struct memUnit *p_memUnit;	// buddy memory unit of the slab
+	int sizeClass;
+	int objects;
+	int used;
+	unsigned int bitmap;	// occupied objects
+	int next;	// partial slab list of the size class
+	int prev;
+};
+
+struct slabAllocator
+{
+	struct slab slabs[MEMORY_SIZE / SLAB_SIZE];	// indexed by start / SLAB_SIZE
+	int partial[SLAB_CLASSES];	// slabs with free objects
+	struct memUnit objects[MEMORY_SIZE / SMALLEST_ALLOCATION_UNIT];	// object memory units indexed by start / SMALLEST_ALLOCATION_UNIT
+	struct memUnit *memory;
+	int slabsAllocated;
+};
+
+struct slabAllocator slabs;
+
+char *allocatorNames[ALLOCATORS] = {"buddy", "first-fit", "best-fit", "next-fit", "tlsf", "buddy-slab"};
+
+int allocatorFromName(char *name)
+{
+	for (int i = 0; i < ALLOCATORS; i++)
+	{
+		if (strcmp(name, allocatorNames[i]) == 0)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+int allocationSizeFor(int memSize)
+{
+	// the buddy system rounds up to a power of two, the others to the smallest allocation unit
+	if (memSize <= SMALLEST_ALLOCATION_UNIT)
+	{
+		return SMALLEST_ALLOCATION_UNIT;
+	}
+	if ((allocatorType == BUDDY_SLAB) && (memSize <= slabClassSizes[SLAB_CLASSES - 1]))
+	{
+		int sizeClass = 0;
+		while (slabClassSizes[sizeClass] < memSize)
+		{
+			sizeClass++;
+		}
+		return slabClassSizes[sizeClass];
+	}
+	if ((allocatorType == BUDDY) || (allocatorType == BUDDY_SLAB))
+	{
+		int allocationSize = SMALLEST_ALLOCATION_UNIT;
+		while (allocationSize < memSize)
+		{
+			allocationSize <<= 1;
+		}
+		return allocationSize;
+	}
+	return (memSize + SMALLEST_ALLOCATION_UNIT - 1) / SMALLEST_ALLOCATION_UNIT * SMALLEST_ALLOCATION_UNIT;
+}
+
+struct memUnit *newBlock(int start, int size, struct memUnit *p_prev, struct memUnit *p_next)
+{
+	struct memUnit *p_block = (struct memUnit *) poolAllocate(&memUnitPool);
+	p_block->id = EMPTY;
+	p_block->size = size;
+	p_block->start = start;
+	p_block->largestFree = size;
+	p_block->parent = NULL;
+	p_block->left = p_prev;
+	p_block->right = p_next;
+	if (p_prev != NULL)
+	{
+		p_prev->right = p_block;
+	}
+	else
+	{
+		blocks.head = p_block;
+	}
+	if (p_next != NULL)
+	{
+		p_next->left = p_block;
+	}
+	return p_block;
+}
+
+// keeps the first size bytes of a free block and returns the rest as a new free block (or NULL)
+struct memUnit *splitBlock(struct memUnit *p_block, int size)
+{
+	if (p_block->size == size)
+	{
+		return NULL;
+	}
+	struct memUnit *p_rest = newBlock(p_block->start + size, p_block->size - size, p_block, p_block->right);
+	p_block->size = size;
+	return p_rest;
+}
+
+// merges a free block with the free block after it
+void mergeNextBlock(struct memUnit *p_block)
+{
+	HOT_PATH_WORK(DEALLOCATE_OPERATION, 1);
+	struct memUnit *p_next = p_block->right;
+	p_block->size += p_next->size;
+	p_block->right = p_next->right;
+	if (p_next->right != NULL)
+	{
+		p_next->right->left = p_block;
+	}
+	if (blocks.rover == p_next)
+	{
+		blocks.rover = p_block;
+	}
+	poolFree(&memUnitPool, p_next);
+}
+
+bool isFreeBlock(struct memUnit *p_block)
+{
+	return (p_block != NULL) && (p_block->id == EMPTY);
+}
+
+void useBlock(struct memUnit *p_block, struct process *p_process)
+{
+	p_block->id = p_process->id;
+	p_block->largestFree = 0;
+	p_process->allocatedMemUnit = p_block;
+	countAllocation(p_process, 1);
+}
+
+void updateLargestFreeBlock()
+{
+	int largestFree = 0;
+	for (struct memUnit *p_block = blocks.head; p_block != NULL; p_block = p_block->right)
+	{
+		if ((p_block->id == EMPTY) && (p_block->size > largestFree))
+		{
+			largestFree = p_block->size;
+		}
+	}
+	blocks.memory->largestFree = largestFree;
+}
+
+bool fitAllocate(struct process *p_process)
+{
+	struct memUnit *p_selectedBlock = NULL;
+	switch (allocatorType)
+	{
+		case FIRST_FIT:
+			for (struct memUnit *p_block = blocks.head; p_block != NULL; p_block = p_block->right)
+			{
+				HOT_PATH_WORK(ALLOCATE_OPERATION, 1);
+				if (isFreeBlock(p_block) && (p_block->size >= p_process->allocationSize))
+				{
+					p_selectedBlock = p_block;
+					break;
+				}
+			}
+			break;
+
+		case BEST_FIT:
+			for (struct memUnit *p_block = blocks.head; p_block != NULL; p_block = p_block->right)
+			{
+				HOT_PATH_WORK(ALLOCATE_OPERATION, 1);
+				if (isFreeBlock(p_block) && (p_block->size >= p_process->allocationSize) && ((p_selectedBlock == NULL) || (p_block->size < p_selectedBlock->size)))
+				{
+					p_selectedBlock = p_block;
+				}
+			}
+			break;
+
+		case NEXT_FIT:
+			// search from the rover to the end then from the start to the rover
+			for (struct memUnit *p_block = blocks.rover; p_block != NULL; p_block = p_block->right)
+			{
+				HOT_PATH_WORK(ALLOCATE_OPERATION, 1);
+				if (isFreeBlock(p_block) && (p_block->size >= p_process->allocationSize))
+				{
+					p_selectedBlock = p_block;
+					break;
+				}
+			}
+			for (struct memUnit *p_block = blocks.head; (p_selectedBlock == NULL) && (p_block != blocks.rover); p_block = p_block->right)
+			{
+				HOT_PATH_WORK(ALLOCATE_OPERATION, 1);
+				if (isFreeBlock(p_block) && (p_block->size >= p_process->allocationSize))
+				{
+					p_selectedBlock = p_block;
+				}
+			}
+			break;
+	}
+
+	if (p_selectedBlock == NULL)
+	{
+		return false;
+	}
+	splitBlock(p_selectedBlock, p_process->allocationSize);
+	useBlock(p_selectedBlock, p_process);
+	blocks.rover = (p_selectedBlock->right != NULL) ? p_selectedBlock->right : blocks.head;
+	updateLargestFreeBlock();
+	return true;
+}
+
+void fitDeallocate(struct process *p_process)
+{
+	struct memUnit *p_block = p_process->allocatedMemUnit;
+	p_block->id = EMPTY;
+	p_process->allocatedMemUnit = NULL;
+	countAllocation(p_process, -1);
+
+	// coalesce with free neighbours
+	if (isFreeBlock(p_block->right))
+	{
+		mergeNextBlock(p_block);
+	}
+	if (isFreeBlock(p_block->left))
+	{
+		p_block = p_block->left;
+		mergeNextBlock(p_block);
+	}
+	p_block->largestFree = p_block->size;
+	updateLargestFreeBlock();
+}
+
+// maps a size in allocation units to its TLSF class
+void tlsfMapping(int units, int *fl, int *sl)
+{
+	*fl = 31 - __builtin_clz(units);
+	if (*fl < TLSF_SL_LOG2)
+	{
+		*sl = units - (1 << *fl);
+	}
+	else
+	{
+		*sl = (units >> (*fl - TLSF_SL_LOG2)) - TLSF_SL_COUNT;
+	}
+}
+
+void tlsfInsert(struct memUnit *p_block)
+{
+	int fl, sl;
+	tlsfMapping(p_block->size / SMALLEST_ALLOCATION_UNIT, &fl, &sl);
+	int index = p_block->start / SMALLEST_ALLOCATION_UNIT;
+	struct memUnit *p_head = blocks.classes[fl][sl];
+	blocks.nextFree[index] = p_head;
+	blocks.prevFree[index] = NULL;
+	if (p_head != NULL)
+	{
+		blocks.prevFree[p_head->start / SMALLEST_ALLOCATION_UNIT] = p_block;
+	}
+	blocks.classes[fl][sl] = p_block;
+	blocks.flBitmap |= 1U << fl;
+	blocks.slBitmap[fl] |= 1U << sl;
+}
+
+void tlsfRemove(struct memUnit *p_block)
+{
+	int fl, sl;
+	tlsfMapping(p_block->size / SMALLEST_ALLOCATION_UNIT, &fl, &sl);
+	int index = p_block->start / SMALLEST_ALLOCATION_UNIT;
+	struct memUnit *p_next = blocks.nextFree[index];
+	struct memUnit *p_prev = blocks.prevFree[index];
+	if (p_next != NULL)
+	{
+		blocks.prevFree[p_next->start / SMALLEST_ALLOCATION_UNIT] = p_prev;
+	}
+	if (p_prev != NULL)
+	{
+		blocks.nextFree[p_prev->start / SMALLEST_ALLOCATION_UNIT] = p_next;
+	}
+	else
+	{
+		blocks.classes[fl][sl] = p_next;
+		if (p_next == NULL)
+		{
+			blocks.slBitmap[fl] &= ~(1U << sl);
+			if (blocks.slBitmap[fl] == 0)
+			{
+				blocks.flBitmap &= ~(1U << fl);
+			}
+		}
+	}
+}
+
+// finds the first non-empty class whose blocks all fit the given size, returns false if there is none
+bool tlsfFindClass(int allocationSize, int *fl, int *sl)
+{
+	// round the size up to the next class so that any block of the class fits
+	int units = allocationSize / SMALLEST_ALLOCATION_UNIT;
+	*fl = 31 - __builtin_clz(units);
+	if (*fl >= TLSF_SL_LOG2)
+	{
+		units += (1 << (*fl - TLSF_SL_LOG2)) - 1;
+	}
+	tlsfMapping(units, fl, sl);
+
+	// find the first non-empty class at or above it
+	if (*fl >= TLSF_FL_COUNT)
+	{
+		return false;
+	}
+	unsigned int slMap = blocks.slBitmap[*fl] & (~0U << *sl);
+	if (slMap == 0)
+	{
+		unsigned int flMap = (*fl + 1 < TLSF_FL_COUNT) ? blocks.flBitmap & (~0U << (*fl + 1)) : 0;
+		if (flMap == 0)
+		{
+			return false;
+		}
+		*fl = __builtin_ctz(flMap);
+		slMap = blocks.slBitmap[*fl];
+	}
+	*sl = __builtin_ctz(slMap);
+	return true;
+}
+
+bool tlsfAllocate(struct process *p_process)
+{
+	int fl, sl;
+	if (!tlsfFindClass(p_process->allocationSize, &fl, &sl))
+	{
+		return false;
+	}
+
+	struct memUnit *p_block = blocks.classes[fl][sl];
+	tlsfRemove(p_block);
+	struct memUnit *p_rest = splitBlock(p_block, p_process->allocationSize);
+	if (p_rest != NULL)
+	{
+		tlsfInsert(p_rest);
+	}
+	useBlock(p_block, p_process);
+	return true;
+}
+
+void tlsfDeallocate(struct process *p_process)
+{
+	struct memUnit *p_block = p_process->allocatedMemUnit;
+	p_block->id = EMPTY;
+	p_process->allocatedMemUnit = NULL;
+	countAllocation(p_process, -1);
+
+	// coalesce with free neighbours
+	if (isFreeBlock(p_block->right))
+	{
+		tlsfRemove(p_block->right);
+		mergeNextBlock(p_block);
+	}
+	if (isFreeBlock(p_block->left))
+	{
+		p_block = p_block->left;
+		tlsfRemove(p_block);
+		mergeNextBlock(p_block);
+	}
+	p_block->largestFree = p_block->size;
+	tlsfInsert(p_block);
+}
+
+int slabClass(int allocationSize)
+{
+	int sizeClass = 0;
+	while (slabClassSizes[sizeClass] != allocationSize)
+	{
+		sizeClass++;
+	}
+	return sizeClass;
+}
+
+void slabListRemove(int slabIndex)
+{
+	struct slab *p_slab = &slabs.slabs[slabIndex];
+	if (p_slab->prev == -1)
+	{
+		slabs.partial[p_slab->sizeClass] = p_slab->next;
+	}
+	else
+	{
+		slabs.slabs[p_slab->prev].next = p_slab->next;
+	}
+	if (p_slab->next != -1)
+	{
+		slabs.slabs[p_slab->next].prev = p_slab->prev;
+	}
+}
+
+void slabListPush(int slabIndex)
+{
+	struct slab *p_slab = &slabs.slabs[slabIndex];
+	p_slab->prev = -1;
+	p_slab->next = slabs.partial[p_slab->sizeClass];
+	if (p_slab->next != -1)
+	{
+		slabs.slabs[p_slab->next].prev = slabIndex;
+	}
+	slabs.partial[p_slab->sizeClass] = slabIndex;
+}
+
+// allocates a new slab for a size class from the buddy system and returns its index (-1 if memory is full)
+int newSlab(int sizeClass)
+{
+	struct process slabPage;
+	slabPage.id = SLAB_PAGE;
+	slabPage.memSize = SLAB_SIZE;
+	slabPage.allocationSize = SLAB_SIZE;
+	slabPage.allocatedMemUnit = NULL;
+	if (!buddyAllocate(slabs.memory, &slabPage))
+	{
+		if (slabPage.allocatedMemUnit == NULL)
+		{
+			return -1;
+		}
+		splitAllocate(&slabPage);
+	}
+	countAllocation(&slabPage, -1);	// slabs are counted through their objects
+
+	int slabIndex = slabPage.allocatedMemUnit->start / SLAB_SIZE;
+	struct slab *p_slab = &slabs.slabs[slabIndex];
+	p_slab->p_memUnit = slabPage.allocatedMemUnit;
+	p_slab->sizeClass = sizeClass;
+	p_slab->objects = SLAB_SIZE / slabClassSizes[sizeClass];
+	p_slab->used = 0;
+	p_slab->bitmap = 0;
+	slabListPush(slabIndex);
+	slabs.slabsAllocated++;
+	return slabIndex;
+}
+
+void freeSlab(int slabIndex)
+{
+	struct process slabPage;
+	slabPage.id = SLAB_PAGE;
+	slabPage.memSize = SLAB_SIZE;
+	slabPage.allocationSize = SLAB_SIZE;
+	slabPage.allocatedMemUnit = slabs.slabs[slabIndex].p_memUnit;
+	countAllocation(&slabPage, 1);
+	buddyDeallocate(&slabPage);
+}
+
+bool slabAllocate(struct process *p_process)
+{
+	int sizeClass = slabClass(p_process->allocationSize);
+	int slabIndex = slabs.partial[sizeClass];
+	if (slabIndex == -1)
+	{
+		slabIndex = newSlab(sizeClass);
+		if (slabIndex == -1)
+		{
+			return false;
+		}
+	}
+
+	// take the first free object of the slab
+	struct slab *p_slab = &slabs.slabs[slabIndex];
+	int object = __builtin_ctz(~p_slab->bitmap);
+	p_slab->bitmap |= 1U << object;
+	p_slab->used++;
+	if (p_slab->used == p_slab->objects)
+	{
+		slabListRemove(slabIndex);
+	}
+
+	int start = p_slab->p_memUnit->start + object * p_process->allocationSize;
+	struct memUnit *p_object = &slabs.objects[start / SMALLEST_ALLOCATION_UNIT];
+	p_object->id = p_process->id;
+	p_object->size = p_process->allocationSize;
+	p_object->start = start;
+	p_object->largestFree = 0;
+	p_object->parent = p_slab->p_memUnit;
+	p_object->left = NULL;
+	p_object->right = NULL;
+	p_process->allocatedMemUnit = p_object;
+	countAllocation(p_process, 1);
+	return true;
+}
+
+void slabDeallocate(struct process *p_process)
+{
+	struct memUnit *p_object = p_process->allocatedMemUnit;
+	int slabIndex = p_object->parent->start / SLAB_SIZE;
+	struct slab *p_slab = &slabs.slabs[slabIndex];
+	int object = (p_object->start - p_slab->p_memUnit->start) / p_object->size;
+	p_object->id = EMPTY;
+	p_process->allocatedMemUnit = NULL;
+	countAllocation(p_process, -1);
+
+	if (p_slab->used == p_slab->objects)
+	{
+		slabListPush(slabIndex);
+	}
+	p_slab->bitmap &= ~(1U << object);
+	p_slab->used--;
+
+	// return empty slabs to the buddy system
+	if (p_slab->used == 0)
+	{
+		slabListRemove(slabIndex);
+		freeSlab(slabIndex);
+	}
+}
+
+// creates the free block covering the whole memory for the variable-size allocators
+void initAllocator(struct memUnit *memory)
+{
+	if (allocatorType == BUDDY)
+	{
+		return;
+	}
+	if (allocatorType == BUDDY_SLAB)
+	{
+		memset(&slabs, 0, sizeof(struct slabAllocator));
+		slabs.memory = memory;
+		for (int i = 0; i < SLAB_CLASSES; i++)
+		{
+			slabs.partial[i] = -1;
+		}
+		return;
+	}
+	memset(&blocks, 0, sizeof(struct blockList));
+	blocks.memory = memory;
+	blocks.rover = newBlock(0, MEMORY_SIZE, NULL, NULL);
+	if (allocatorType == TLSF)
+	{
+		tlsfInsert(blocks.head);
+	}
+}
+
+// returns the size of the largest free memory unit. TLSF does not keep largestFree, which would
+// take a scan of the highest class on every allocation, so its largest block is found here.
+int largestFreeSize(struct memUnit *memory)
+{
+	if (allocatorType != TLSF)
+	{
+		return memory->largestFree;
+	}
+
+	// the largest free block is in the highest non-empty class
+	if (blocks.flBitmap == 0)
+	{
+		return 0;
+	}
+	int fl = 31 - __builtin_clz(blocks.flBitmap);
+	int sl = 31 - __builtin_clz(blocks.slBitmap[fl]);
+	int largestFree = 0;
+	for (struct memUnit *p_block = blocks.classes[fl][sl]; p_block != NULL; p_block = blocks.nextFree[p_block->start / SMALLEST_ALLOCATION_UNIT])
+	{
+		if (p_block->size > largestFree)
+		{
+			largestFree = p_block->size;
+		}
+	}
+	return largestFree;
+}
+
+// returns false if a process of the given size cannot be allocated
+bool mayFit(struct memUnit *memory, int allocationSize)
+{
+	if ((allocatorType == BUDDY_SLAB) && (allocationSize <= slabClassSizes[SLAB_CLASSES - 1]))
+	{
+		// a partial slab of the size class, or a new slab from the buddy system
+		return (slabs.partial[slabClass(allocationSize)] != -1) || (SLAB_SIZE <= memory->largestFree);
+	}
+	if (allocatorType == TLSF)
+	{
+		// TLSF only allocates from a class whose blocks all fit, which a larger block may not be in
+		int fl, sl;
+		return tlsfFindClass(allocationSize, &fl, &sl);
+	}
+	return allocationSize <= memory->largestFree;
+}
+
+// allocates a process in memory. For the buddy system a false result with a memory unit
+// set means that the memory unit must be split with splitAllocate.
+bool allocate(struct memUnit *memory, struct process *p_process)
+{
+	HOT_PATH_TIMER(ALLOCATE_OPERATION);
+	switch (allocatorType)
+	{
+		case BUDDY:
+			return buddyAllocate(memory, p_process);
+
+		case TLSF:
+			return tlsfAllocate(p_process);
+
+		case BUDDY_SLAB:
+			if (p_process->allocationSize <= slabClassSizes[SLAB_CLASSES - 1])
+			{
+				return slabAllocate(p_process);
+			}
+			return buddyAllocate(memory, p_process);
+
+		default:
+			return fitAllocate(p_process);
+	}
+}
+
+void deallocate(struct process *p_process)
+{
+	HOT_PATH_TIMER(DEALLOCATE_OPERATION);
+	switch (allocatorType)
+	{
+		case BUDDY:
+			buddyDeallocate(p_process);
+			return;
+
+		case TLSF:
+			tlsfDeallocate(p_process);
+			return;
+
+		case BUDDY_SLAB:
+			if (p_process->allocationSize <= slabClassSizes[SLAB_CLASSES - 1])
+			{
+				slabDeallocate(p_process);
+			}
+			else
+			{
+				buddyDeallocate(p_process);
+			}
+			return;
+
+		default:
+			fitDeallocate(p_process);
+			return;
+	}
+}
@@ -0,0 +1,427 @@
+// EASY backfilling admission. The earliest waiting process holds a reservation: the earliest
+// time (shadow time) at which the resident processes will have freed enough memory for it, in a
+// free range the allocator can use, assuming they finish in order of remaining time. A process
+// behind it may only be allocated if doing so does not move the shadow time later. The residents
+// are kept in a heap on remaining time, and the allocation units they cover in a tree of free
+// runs, so a shadow time only visits the residents that finish before it.
+
+struct backfillState
+{
+	struct process *p_processBufferStart;
+	int schedulerType;
+
+	// resident processes in a binary min-heap on remaining time, the heap position of each process
+	// index (-1 if it is not resident) and the allocation units each resident covers
+	int *residents;
+	int *position;
+	int residentCount;
+	int *firstUnit;
+	int *units;
+
+	// heap positions of the residents not yet visited by a shadow time (a heap itself), and the
+	// residents it freed, which are covered again when it returns
+	int *frontier;
+	int *finished;
+
+	// residents (or slab objects) covering each allocation unit, and a tree over the units with the
+	// free runs of each subtree (at its start, at its end and the longest) and the number of entirely
+	// free subtrees of each size, which are the free buddy units
+	int covered[BLOCKS];
+	int prefixFree[2 * BLOCKS];
+	int suffixFree[2 * BLOCKS];
+	int longestFree[2 * BLOCKS];
+	int freeSubtrees[ALLOCATION_ORDERS];
+
+	// admission decisions, indexed by process index
+	bool *allowed;	// allowed ahead of the reservation by its last check
+	bool *held;	// held back at least once
+
+	// statistics
+	int backfilled;
+	int heldBack;
+};
+
+struct backfillState backfill;
+
+void initBackfill(int N, struct process *p_processBufferStart, int schedulerType)
+{
+	backfill.p_processBufferStart = p_processBufferStart;
+	backfill.schedulerType = schedulerType;
+	backfill.residents = (int *) malloc(N * sizeof(int));
+	backfill.position = (int *) malloc(N * sizeof(int));
+	backfill.residentCount = 0;
+	backfill.firstUnit = (int *) malloc(N * sizeof(int));
+	backfill.units = (int *) malloc(N * sizeof(int));
+	backfill.frontier = (int *) malloc(N * sizeof(int));
+	backfill.finished = (int *) malloc(N * sizeof(int));
+	backfill.allowed = (bool *) calloc(N, sizeof(bool));
+	backfill.held = (bool *) calloc(N, sizeof(bool));
+	for (int i = 0; i < N; i++)
+	{
+		backfill.position[i] = -1;
+	}
+
+	// all units are free
+	for (int node = 1; node < 2 * BLOCKS; node++)
+	{
+		int length = BLOCKS >> (31 - __builtin_clz(node));
+		backfill.prefixFree[node] = length;
+		backfill.suffixFree[node] = length;
+		backfill.longestFree[node] = length;
+	}
+	for (int level = 0; level < ALLOCATION_ORDERS; level++)
+	{
+		backfill.freeSubtrees[level] = BLOCKS >> level;
+	}
+	memset(backfill.covered, 0, sizeof(backfill.covered));
+}
+
+// orders process indices by remaining time, then by index
+bool finishesBefore(int processIndex, int otherIndex)
+{
+	int remainingTime = backfill.p_processBufferStart[processIndex].remainingTime;
+	int otherRemainingTime = backfill.p_processBufferStart[otherIndex].remainingTime;
+	return (remainingTime < otherRemainingTime) || ((remainingTime == otherRemainingTime) && (processIndex < otherIndex));
+}
+
+void setBackfillResident(int position, int processIndex)
+{
+	backfill.residents[position] = processIndex;
+	backfill.position[processIndex] = position;
+}
+
+void siftUpBackfillResident(int position)
+{
+	int processIndex = backfill.residents[position];
+	while ((position > 0) && finishesBefore(processIndex, backfill.residents[(position - 1) / 2]))
+	{
+		setBackfillResident(position, backfill.residents[(position - 1) / 2]);
+		position = (position - 1) / 2;
+	}
+	setBackfillResident(position, processIndex);
+}
+
+void siftDownBackfillResident(int position)
+{
+	int processIndex = backfill.residents[position];
+	while (2 * position + 1 < backfill.residentCount)
+	{
+		int child = 2 * position + 1;
+		if ((child + 1 < backfill.residentCount) && finishesBefore(backfill.residents[child + 1], backfill.residents[child]))
+		{
+			child++;
+		}
+		if (!finishesBefore(backfill.residents[child], processIndex))
+		{
+			break;
+		}
+		setBackfillResident(position, backfill.residents[child]);
+		position = child;
+	}
+	setBackfillResident(position, processIndex);
+}
+
+// recomputes the free runs above a unit whose coverage changed between zero and non-zero
+void updateFreeUnit(int unit)
+{
+	int node = BLOCKS + unit;
+	int free = (backfill.covered[unit] == 0) ? 1 : 0;
+	backfill.freeSubtrees[0] += free - backfill.longestFree[node];
+	backfill.prefixFree[node] = free;
+	backfill.suffixFree[node] = free;
+	backfill.longestFree[node] = free;
+	for (int level = 1; node > 1; level++)
+	{
+		node /= 2;
+		int length = 1 << level;
+		int half = length / 2;
+		int left = 2 * node;
+		int right = left + 1;
+		bool wasFree = (backfill.longestFree[node] == length);
+		backfill.prefixFree[node] = (backfill.prefixFree[left] == half) ? half + backfill.prefixFree[right] : backfill.prefixFree[left];
+		backfill.suffixFree[node] = (backfill.suffixFree[right] == half) ? half + backfill.suffixFree[left] : backfill.suffixFree[right];
+		int longest = backfill.suffixFree[left] + backfill.prefixFree[right];
+		longest = (backfill.longestFree[left] > longest) ? backfill.longestFree[left] : longest;
+		longest = (backfill.longestFree[right] > longest) ? backfill.longestFree[right] : longest;
+		backfill.longestFree[node] = longest;
+		backfill.freeSubtrees[level] += (longest == length) - wasFree;
+	}
+}
+
+void coverUnits(int firstUnit, int units, int delta)
+{
+	for (int unit = firstUnit; unit < firstUnit + units; unit++)
+	{
+		backfill.covered[unit] += delta;
+		if (backfill.covered[unit] == ((delta > 0) ? delta : 0))
+		{
+			updateFreeUnit(unit);
+		}
+	}
+}
+
+// returns the allocation units a memory unit frees. A slab object frees its slab after the last
+// object of the slab.
+void freedUnits(struct memUnit *p_memUnit, int allocationSize, int *firstUnit, int *units)
+{
+	int start = p_memUnit->start;
+	if ((allocatorType == BUDDY_SLAB) && (allocationSize <= slabClassSizes[SLAB_CLASSES - 1]))
+	{
+		start = start / SLAB_SIZE * SLAB_SIZE;
+		allocationSize = SLAB_SIZE;
+	}
+	*firstUnit = start / SMALLEST_ALLOCATION_UNIT;
+	*units = allocationSize / SMALLEST_ALLOCATION_UNIT;
+}
+
+#ifdef DYNAMIC_ALLOCATION
+void coverBlock(struct process *p_block, int delta)
+{
+	int firstUnit, units;
+	freedUnits(p_block->allocatedMemUnit, p_block->allocationSize, &firstUnit, &units);
+	coverUnits(firstUnit, units, delta);
+}
+
+// called when a block is allocated (delta 1) or before it is freed (delta -1). The blocks of a
+// finished process are freed after it, so their units were already freed with the process.
+void coverBackfillBlock(struct process *p_block, int delta)
+{
+	if (backfill.position[(p_block - dynamicAllocation.blocks) / BLOCKS_PER_PROCESS] != -1)
+	{
+		coverBlock(p_block, delta);
+	}
+}
+#endif
+
+// covers (delta 1) or frees (delta -1) the units of a resident and of its blocks
+void coverResident(int processIndex, int delta)
+{
+	coverUnits(backfill.firstUnit[processIndex], backfill.units[processIndex], delta);
+	#ifdef DYNAMIC_ALLOCATION
+		// the blocks of a process are freed when it finishes
+		struct process *p_blocks = dynamicAllocation.blocks + processIndex * BLOCKS_PER_PROCESS;
+		for (int handle = 0; handle < BLOCKS_PER_PROCESS; handle++)
+		{
+			if (p_blocks[handle].allocatedMemUnit != NULL)
+			{
+				coverBlock(p_blocks + handle, delta);
+			}
+		}
+	#endif
+}
+
+// called when a process is allocated memory, which counts it as backfilled if it was allowed ahead of the reservation
+void addBackfillResident(struct process *p_process)
+{
+	int processIndex = p_process->id - 1;
+	if (backfill.allowed[processIndex])
+	{
+		backfill.allowed[processIndex] = false;
+		backfill.backfilled++;
+	}
+	setBackfillResident(backfill.residentCount++, processIndex);
+	siftUpBackfillResident(backfill.residentCount - 1);
+	freedUnits(p_process->allocatedMemUnit, p_process->allocationSize, &backfill.firstUnit[processIndex], &backfill.units[processIndex]);
+	coverUnits(backfill.firstUnit[processIndex], backfill.units[processIndex], 1);
+}
+
+// called after a process is freed, with the units it covered when it was allocated
+void removeBackfillResident(struct process *p_process)
+{
+	int processIndex = p_process->id - 1;
+	coverResident(processIndex, -1);
+	int position = backfill.position[processIndex];
+	int lastIndex = backfill.residents[--backfill.residentCount];
+	backfill.position[processIndex] = -1;
+	if (position < backfill.residentCount)
+	{
+		setBackfillResident(position, lastIndex);
+		siftUpBackfillResident(position);
+		siftDownBackfillResident(backfill.position[lastIndex]);
+	}
+}
+
+// called after the running process progressed, which only moves it towards the top of the heap
+void updateBackfillResident(struct process *p_process)
+{
+	int position = backfill.position[p_process->id - 1];
+	if (position != -1)
+	{
+		siftUpBackfillResident(position);
+	}
+}
+
+// called after compaction moved a resident
+void moveBackfillResident(struct process *p_process)
+{
+	int processIndex = p_process->id - 1;
+	coverUnits(backfill.firstUnit[processIndex], backfill.units[processIndex], -1);
+	freedUnits(p_process->allocatedMemUnit, p_process->allocationSize, &backfill.firstUnit[processIndex], &backfill.units[processIndex]);
+	coverUnits(backfill.firstUnit[processIndex], backfill.units[processIndex], 1);
+}
+
+// returns true if the free units hold a range the allocator can use for the reserved process. The
+// buddy system needs a free unit aligned to the size of the process (a new slab for small
+// processes), the other allocators any free range.
+bool reservationFits(struct process *p_reservedProcess)
+{
+	int units = p_reservedProcess->allocationSize / SMALLEST_ALLOCATION_UNIT;
+	if ((allocatorType == BUDDY_SLAB) && (p_reservedProcess->allocationSize <= slabClassSizes[SLAB_CLASSES - 1]))
+	{
+		if (slabs.partial[slabClass(p_reservedProcess->allocationSize)] != -1)
+		{
+			return true;
+		}
+		units = SLAB_SIZE / SMALLEST_ALLOCATION_UNIT;
+	}
+	if ((allocatorType == BUDDY) || (allocatorType == BUDDY_SLAB))
+	{
+		return backfill.freeSubtrees[__builtin_ctz(units)] > 0;
+	}
+	return backfill.longestFree[1] >= units;
+}
+
+void pushFrontier(int *frontierCount, int position)
+{
+	int i = (*frontierCount)++;
+	while ((i > 0) && finishesBefore(backfill.residents[position], backfill.residents[backfill.frontier[(i - 1) / 2]]))
+	{
+		backfill.frontier[i] = backfill.frontier[(i - 1) / 2];
+		i = (i - 1) / 2;
+	}
+	backfill.frontier[i] = position;
+}
+
+int popFrontier(int *frontierCount)
+{
+	int top = backfill.frontier[0];
+	int position = backfill.frontier[--(*frontierCount)];
+	int i = 0;
+	while (2 * i + 1 < *frontierCount)
+	{
+		int child = 2 * i + 1;
+		if ((child + 1 < *frontierCount) && finishesBefore(backfill.residents[backfill.frontier[child + 1]], backfill.residents[backfill.frontier[child]]))
+		{
+			child++;
+		}
+		if (!finishesBefore(backfill.residents[backfill.frontier[child]], backfill.residents[position]))
+		{
+			break;
+		}
+		backfill.frontier[i] = backfill.frontier[child];
+		i = child;
+	}
+	backfill.frontier[i] = position;
+	return top;
+}
+
+// returns the time until the resident processes (and the candidate, if any) free enough memory
+// for the reserved process, in bytes and as one free range. The processes run one after the other
+// in SRTN and share the CPU in RR. Where the candidate would be allocated is not known, so it only
+// takes free bytes. The residents are visited in finishing order by taking the heap positions in
+// order from a frontier of the heap, and the units of each are freed until the reservation fits.
+int shadowTime(struct process *p_reservedProcess, struct process *p_candidateProcess)
+{
+	int free = MEMORY_SIZE - memoryCounters.allocatedBytes - ((p_candidateProcess != NULL) ? p_candidateProcess->allocationSize : 0);
+	int count = backfill.residentCount + ((p_candidateProcess != NULL) ? 1 : 0);
+	int frontierCount = 0;
+	int finishedCount = 0;
+	if (backfill.residentCount > 0)
+	{
+		pushFrontier(&frontierCount, 0);
+	}
+
+	int elapsed = 0;
+	int previousRemainingTime = 0;
+	for (int k = 0; (k < count) && ((free < p_reservedProcess->allocationSize) || !reservationFits(p_reservedProcess)); k++)
+	{
+		// the candidate finishes before the residents with a longer remaining time
+		struct process *p_process;
+		if ((p_candidateProcess != NULL) && ((frontierCount == 0) || (p_candidateProcess->remainingTime < backfill.p_processBufferStart[backfill.residents[backfill.frontier[0]]].remainingTime)))
+		{
+			p_process = p_candidateProcess;
+			p_candidateProcess = NULL;
+		}
+		else
+		{
+			int position = popFrontier(&frontierCount);
+			if (2 * position + 1 < backfill.residentCount)
+			{
+				pushFrontier(&frontierCount, 2 * position + 1);
+			}
+			if (2 * position + 2 < backfill.residentCount)
+			{
+				pushFrontier(&frontierCount, 2 * position + 2);
+			}
+			int processIndex = backfill.residents[position];
+			coverResident(processIndex, -1);
+			backfill.finished[finishedCount++] = processIndex;
+			p_process = backfill.p_processBufferStart + processIndex;
+		}
+
+		if (backfill.schedulerType == RR)
+		{
+			// the remaining processes progress together until this one finishes
+			elapsed += (p_process->remainingTime - previousRemainingTime) * (count - k);
+		}
+		else
+		{
+			elapsed += p_process->remainingTime;
+		}
+		previousRemainingTime = p_process->remainingTime;
+		free += p_process->allocationSize;
+	}
+
+	// cover the units of the visited residents again
+	for (int i = 0; i < finishedCount; i++)
+	{
+		coverResident(backfill.finished[i], 1);
+	}
+	return elapsed;
+}
+
+struct waitingProcess *earliestWaitingProcess(struct waitingQueue *waitingList)
+{
+	struct waitingProcess *p_earliestWaitingProcess = NULL;
+	for (int order = 0; order < ALLOCATION_ORDERS; order++)
+	{
+		struct waitingProcess *p_headWaitingProcess = waitingList->classes[order].head;
+		if ((p_headWaitingProcess != NULL) && ((p_earliestWaitingProcess == NULL) || (p_headWaitingProcess->sequence < p_earliestWaitingProcess->sequence)))
+		{
+			p_earliestWaitingProcess = p_headWaitingProcess;
+		}
+	}
+	return p_earliestWaitingProcess;
+}
+
+// returns true if the process can be allocated without delaying the reservation of the earliest
+// waiting process. A process is counted once as held back, and once as backfilled when it is
+// allocated after being allowed ahead of the reservation.
+bool canBackfill(struct waitingQueue *waitingList, struct process *p_process)
+{
+	int processIndex = p_process->id - 1;
+	struct waitingProcess *p_earliestWaitingProcess = earliestWaitingProcess(waitingList);
+	if ((p_earliestWaitingProcess == NULL) || (p_earliestWaitingProcess->p_process == p_process))
+	{
+		backfill.allowed[processIndex] = false;
+		return true;
+	}
+	struct process *p_reservedProcess = p_earliestWaitingProcess->p_process;
+	if (shadowTime(p_reservedProcess, p_process) > shadowTime(p_reservedProcess, NULL))
+	{
+		if (!backfill.held[processIndex])
+		{
+			backfill.held[processIndex] = true;
+			backfill.heldBack++;
+		}
+		backfill.allowed[processIndex] = false;
+		return false;
+	}
+	backfill.allowed[processIndex] = true;
+	return true;
+}
+
+void writeBackfillPerformance(FILE *pFile)
+{
+	fprintf(pFile, "Backfill admissions: %d processes allocated ahead of the reservation, %d processes held back\n", backfill.backfilled, backfill.heldBack);
+}
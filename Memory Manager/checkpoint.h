@@ -0,0 +1,434 @@
+// Checkpoints. Every CHECKPOINT_INTERVAL time steps the scheduler saves the state of the
+// simulation after the scheduling step into checkpoint.bin (format in checkpoint_file.h): the
+// memory shared with the generator (scheduler info, ready queue and process buffer), the PCBs,
+// the buddy tree, the waiting list, the performance statistics and the time step to resume at.
+// The file is written by a forked child from its copy-on-write image of the scheduler, into a
+// temporary file that replaces the last checkpoint when it is complete, so the scheduler goes on
+// with the next time step. Only the memory shared with the generator and the processes, which is
+// not copy-on-write, is copied before the fork. A simulation started with OSSIM_RESUME naming a
+// checkpoint continues from it with the same logs as a simulation that was not interrupted.
+#include <time.h>
+#include "checkpoint_file.h"
+
+#if defined(PAGING) || defined(BACKFILLING) || defined(SWAPPING) || defined(COMPACTION) || defined(MEMORY_STATS) || defined(REAL_MEMORY) || defined(DYNAMIC_ALLOCATION)
+#error "CHECKPOINT does not save the state of PAGING, BACKFILLING, SWAPPING, COMPACTION, MEMORY_STATS, REAL_MEMORY or DYNAMIC_ALLOCATION"
+#endif
+#if defined(BINARY_LOG) || defined(TRACE_EXPORT)
+#error "CHECKPOINT cannot continue the logs of BINARY_LOG or TRACE_EXPORT"
+#endif
+
+// time steps between checkpoints (can be overridden with -D)
+#ifndef CHECKPOINT_INTERVAL
+#define CHECKPOINT_INTERVAL 100
+#endif
+
+struct checkpointPCB
+{
+	int started;
+	struct PCB PCB;
+};
+
+struct checkpointMemUnit
+{
+	int id;
+	int size;
+	int start;
+	int largestFree;
+	int split;	// followed by the left and the right memory units
+};
+
+struct checkpointWaitingProcess
+{
+	int process;	// index in the process buffer
+	int sequence;
+};
+
+struct checkpointStats
+{
+	struct performanceStats performance;
+	struct memoryCounters memoryCounters;
+	int waitingProcessAllocations;
+	int waitingProcessMallocs;
+	int memUnitAllocations;
+	int memUnitMallocs;
+};
+
+struct checkpointState
+{
+	pid_t writer;		// child writing the last checkpoint, 0 if none
+	int written;
+	int skipped;		// checkpoints skipped while the last one was still being written
+	double stallTime;	// time the scheduler spent copying and forking
+	long logLength;		// lengths of the logs at the checkpoint, taken before the fork since the
+	long memLogLength;	// child shares the file offsets with the scheduler
+	#ifndef IN_PROCESS
+		char *shared;		// copies of the memory shared with the generator and the processes
+		struct PCB *PCBs;
+	#endif
+};
+
+struct checkpointState checkpoints;
+
+void initCheckpoints(int N)
+{
+	checkpoints.writer = 0;
+	checkpoints.written = 0;
+	checkpoints.skipped = 0;
+	checkpoints.stallTime = 0;
+	if (allocatorType != BUDDY)
+	{
+		printf("Checkpoints need the buddy allocator, no checkpoint will be written\n");
+	}
+	#ifdef IN_PROCESS
+		(void) N;
+	#else
+		checkpoints.shared = (char *) malloc(SHARED_MEMORY_SIZE(N));
+		checkpoints.PCBs = (struct PCB *) calloc(N, sizeof(struct PCB));
+	#endif
+}
+
+long checkpointAlign(long offset)
+{
+	return (offset + CHECKPOINT_ALIGNMENT - 1) / CHECKPOINT_ALIGNMENT * CHECKPOINT_ALIGNMENT;
+}
+
+int countMemUnits(struct memUnit *p_memUnit)
+{
+	return (p_memUnit->left == NULL) ? 1 : 1 + countMemUnits(p_memUnit->left) + countMemUnits(p_memUnit->right);
+}
+
+struct checkpointMemUnit *saveMemUnit(struct checkpointMemUnit *p_record, struct memUnit *p_memUnit)
+{
+	p_record->id = p_memUnit->id;
+	p_record->size = p_memUnit->size;
+	p_record->start = p_memUnit->start;
+	p_record->largestFree = p_memUnit->largestFree;
+	p_record->split = (p_memUnit->left != NULL);
+	p_record++;
+	if (p_memUnit->left != NULL)
+	{
+		p_record = saveMemUnit(p_record, p_memUnit->left);
+		p_record = saveMemUnit(p_record, p_memUnit->right);
+	}
+	return p_record;
+}
+
+// writes the checkpoint from the child, p_shared and PCBs are the memory shared with the
+// generator and the PCBs of the processes
+void writeCheckpoint(char *p_shared, struct PCB *PCBs)
+{
+	int N = simulation.N;
+	struct process *p_processBufferStart = sharedProcessBuffer((struct schedulerInfo *) p_shared);
+	int arrivedProcesses = 0;
+	while ((arrivedProcesses < N) && (p_processBufferStart[arrivedProcesses].id != 0))
+	{
+		arrivedProcesses++;
+	}
+
+	// lay out the sections
+	struct checkpointHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+	header.N = N;
+	header.sharedSize = SHARED_MEMORY_SIZE(N);
+	header.memUnits = countMemUnits(memory);
+	header.waitingProcesses = simulation.waitingList.count;
+	header.sharedOffset = checkpointAlign(sizeof(struct checkpointHeader));
+	header.PCBOffset = checkpointAlign(header.sharedOffset + header.sharedSize);
+	header.memoryOffset = checkpointAlign(header.PCBOffset + N * sizeof(struct checkpointPCB));
+	header.waitingOffset = checkpointAlign(header.memoryOffset + header.memUnits * sizeof(struct checkpointMemUnit));
+	header.statsOffset = checkpointAlign(header.waitingOffset + header.waitingProcesses * sizeof(struct checkpointWaitingProcess));
+	header.size = header.statsOffset + sizeof(struct checkpointStats);
+
+	// state at the start of the next time step (see advanceSimulation)
+	header.time = simulation.currentTime + 1;
+	header.wastedTime = simulation.wastedTime + ((simulation.p_scheduledProcess == NULL) ? 1 : 0);
+	header.memorySize = MEMORY_SIZE;
+	header.processSize = sizeof(struct process);
+	header.PCBSize = sizeof(struct PCB);
+	header.allocatorType = allocatorType;
+	header.arrivedProcesses = arrivedProcesses;
+	header.processesFinished = simulation.processesFinished;
+	header.processQuantum = simulation.processQuantum;
+	header.scheduledProcess = (simulation.p_scheduledProcess != NULL) ? (simulation.p_scheduledProcess - simulation.p_processBufferStart) : -1;
+	header.waitingSequence = simulation.waitingList.sequence;
+	header.logLength = checkpoints.logLength;
+	header.memLogLength = checkpoints.memLogLength;
+
+	// write into a temporary file through a mapping
+	char path[256];
+	char temporaryPath[sizeof(path) + 4];	// path and ".tmp"
+	snprintf(path, sizeof(path), "%s", instancePath(CHECKPOINT_FILE));
+	snprintf(temporaryPath, sizeof(temporaryPath), "%s.tmp", path);
+	int fd = open(temporaryPath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if ((fd == -1) || (ftruncate(fd, header.size) == -1))
+	{
+		perror("Error in creating checkpoint");
+		return;
+	}
+	char *p_file = (char *) mmap(NULL, header.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (p_file == MAP_FAILED)
+	{
+		perror("Error in mapping checkpoint");
+		close(fd);
+		return;
+	}
+
+	memcpy(p_file + header.sharedOffset, p_shared, header.sharedSize);
+
+	struct checkpointPCB *p_PCBs = (struct checkpointPCB *) (p_file + header.PCBOffset);
+	for (int i = 0; i < N; i++)
+	{
+		p_PCBs[i].started = (simulation.processTable[i] != -1);
+		if (p_PCBs[i].started && (p_processBufferStart[i].remainingTime > 0))
+		{
+			p_PCBs[i].PCB = PCBs[i];
+		}
+	}
+
+	saveMemUnit((struct checkpointMemUnit *) (p_file + header.memoryOffset), memory);
+
+	struct checkpointWaitingProcess *p_waitingRecord = (struct checkpointWaitingProcess *) (p_file + header.waitingOffset);
+	for (int order = 0; order < ALLOCATION_ORDERS; order++)
+	{
+		for (struct waitingProcess *p_waitingProcess = simulation.waitingList.classes[order].head; p_waitingProcess != NULL; p_waitingProcess = p_waitingProcess->next)
+		{
+			p_waitingRecord->process = p_waitingProcess->p_process - simulation.p_processBufferStart;
+			p_waitingRecord->sequence = p_waitingProcess->sequence;
+			p_waitingRecord++;
+		}
+	}
+
+	struct checkpointStats *p_stats = (struct checkpointStats *) (p_file + header.statsOffset);
+	p_stats->performance = performance;
+	p_stats->memoryCounters = memoryCounters;
+	p_stats->waitingProcessAllocations = waitingProcessPool.allocations;
+	p_stats->waitingProcessMallocs = waitingProcessPool.mallocs;
+	p_stats->memUnitAllocations = memUnitPool.allocations;
+	p_stats->memUnitMallocs = memUnitPool.mallocs;
+
+	// the header is written last, and the checkpoint replaces the last one once it is on disk
+	memcpy(p_file, &header, sizeof(header));
+	munmap(p_file, header.size);
+	fsync(fd);
+	close(fd);
+	rename(temporaryPath, path);
+}
+
+// writes a checkpoint every CHECKPOINT_INTERVAL time steps, after the scheduling step
+void checkpointSimulation()
+{
+	if ((((simulation.currentTime + 1) % CHECKPOINT_INTERVAL) != 0) || (simulation.processesFinished == simulation.N) || (allocatorType != BUDDY))
+	{
+		return;
+	}
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	
+	// the engine, whose time steps do not follow a clock, waits for the last checkpoint to be
+	// written, and the scheduler skips the checkpoint while the last one is still being written
+	if (checkpoints.writer != 0)
+	{
+		#ifdef IN_PROCESS
+			waitpid(checkpoints.writer, NULL, 0);
+		#else
+			if (waitpid(checkpoints.writer, NULL, WNOHANG) == 0)
+			{
+				checkpoints.skipped++;
+				return;
+			}
+		#endif
+		checkpoints.writer = 0;
+	}
+	#ifdef IN_PROCESS
+		char *p_shared = (char *) simulation.p_schedulerInfo;
+		struct PCB *PCBs = PCBTable;
+	#else
+		// copy the memory shared with the generator and the PCBs of the processes that did not finish
+		char *p_shared = checkpoints.shared;
+		struct PCB *PCBs = checkpoints.PCBs;
+		memcpy(p_shared, simulation.p_schedulerInfo, SHARED_MEMORY_SIZE(simulation.N));
+		for (int i = 0; i < simulation.N; i++)
+		{
+			if ((simulation.processTable[i] != -1) && (simulation.p_processBufferStart[i].remainingTime > 0))
+			{
+				struct PCB *p_PCB = selectPCB(simulation.processTable, &simulation.p_processBufferStart[i]);
+				PCBs[i] = *p_PCB;
+				shmdt(p_PCB);
+			}
+		}
+	#endif
+
+	// the logs are cut back to their lengths at the checkpoint when resuming
+	fflush(simulation.pFile);
+	fflush(simulation.pMemFile);
+	checkpoints.logLength = ftell(simulation.pFile);
+	checkpoints.memLogLength = ftell(simulation.pMemFile);
+
+	pid_t pid = fork();
+	if (pid == -1)
+	{
+		perror("Error in fork\n");
+		return;
+	}
+	if (pid == 0)
+	{
+		// finish the checkpoint when the simulation is interrupted
+		signal(SIGINT, SIG_IGN);
+		writeCheckpoint(p_shared, PCBs);
+		_exit(0);
+	}
+	checkpoints.writer = pid;
+	checkpoints.written++;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	checkpoints.stallTime += (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+// waits for the checkpoint being written and frees the copies
+void destroyCheckpoints()
+{
+	if (checkpoints.writer != 0)
+	{
+		waitpid(checkpoints.writer, NULL, 0);
+		checkpoints.writer = 0;
+	}
+	#ifndef IN_PROCESS
+		free(checkpoints.shared);
+		checkpoints.shared = NULL;
+		free(checkpoints.PCBs);
+		checkpoints.PCBs = NULL;
+	#endif
+}
+
+// returns the length of scheduler.log or memory.log at the checkpoint, or -1 when not resuming
+long resumeLogLength(char *name)
+{
+	struct checkpointHeader *p_checkpoint = resumeCheckpoint();
+	if (p_checkpoint == NULL)
+	{
+		return -1;
+	}
+	return (strcmp(name, LOG) == 0) ? p_checkpoint->logLength : p_checkpoint->memLogLength;
+}
+
+struct checkpointMemUnit *resumeMemUnit(struct checkpointMemUnit *p_record, struct memUnit *p_memUnit, struct memUnit *p_parent)
+{
+	p_memUnit->id = p_record->id;
+	p_memUnit->size = p_record->size;
+	p_memUnit->start = p_record->start;
+	p_memUnit->largestFree = p_record->largestFree;
+	p_memUnit->parent = p_parent;
+	p_memUnit->left = NULL;
+	p_memUnit->right = NULL;
+	if (p_memUnit->id > 0)
+	{
+		// memory unit of a process
+		simulation.p_processBufferStart[p_memUnit->id - 1].allocatedMemUnit = p_memUnit;
+	}
+	bool split = p_record->split;
+	p_record++;
+	if (split)
+	{
+		p_memUnit->left = (struct memUnit *) poolAllocate(&memUnitPool);
+		p_record = resumeMemUnit(p_record, p_memUnit->left, p_memUnit);
+		p_memUnit->right = (struct memUnit *) poolAllocate(&memUnitPool);
+		p_record = resumeMemUnit(p_record, p_memUnit->right, p_memUnit);
+	}
+	return p_record;
+}
+
+// restarts a process that started before the checkpoint and did not finish, with its saved PCB
+struct PCB *restartProcess(int *processTable, int PCB_sem, struct PCB *p_savedPCB)
+{
+	struct PCB *p_PCB = createPCB(processTable, p_savedPCB->id);
+	*p_PCB = *p_savedPCB;
+	#ifdef IN_PROCESS
+		(void) PCB_sem;
+	#else
+		// enable process to read PCB
+		up(PCB_sem);
+	#endif
+	return p_PCB;
+}
+
+// continues the simulation from the checkpoint named by OSSIM_RESUME, after the generator (or
+// the engine) restored the memory it shares with the scheduler
+void resumeSimulation()
+{
+	struct checkpointHeader *p_checkpoint = resumeCheckpoint();
+	if (p_checkpoint == NULL)
+	{
+		return;
+	}
+	char *p_file = (char *) p_checkpoint;
+	int N = simulation.N;
+	if ((p_checkpoint->N != N) || (p_checkpoint->memorySize != MEMORY_SIZE) || (p_checkpoint->processSize != sizeof(struct process)) || (p_checkpoint->PCBSize != sizeof(struct PCB)) || (p_checkpoint->allocatorType != BUDDY))
+	{
+		printf("The checkpoint does not match the simulation\n");
+		exit(-1);
+	}
+
+	// buddy tree, the memory units of the processes are set from it
+	for (int i = 0; i < N; i++)
+	{
+		simulation.p_processBufferStart[i].allocatedMemUnit = NULL;
+	}
+	resumeMemUnit((struct checkpointMemUnit *) (p_file + p_checkpoint->memoryOffset), memory, NULL);
+
+	// waiting list
+	struct checkpointWaitingProcess *p_waitingRecords = (struct checkpointWaitingProcess *) (p_file + p_checkpoint->waitingOffset);
+	for (int i = 0; i < p_checkpoint->waitingProcesses; i++)
+	{
+		struct process *p_process = simulation.p_processBufferStart + p_waitingRecords[i].process;
+		addToWaitingList(&simulation.waitingList, p_process);
+		simulation.waitingList.classes[allocationOrder(p_process->allocationSize)].tail->sequence = p_waitingRecords[i].sequence;
+	}
+	simulation.waitingList.sequence = p_checkpoint->waitingSequence;
+
+	// restart the processes that started and did not finish with their PCBs
+	struct checkpointPCB *p_PCBs = (struct checkpointPCB *) (p_file + p_checkpoint->PCBOffset);
+	for (int i = 0; i < N; i++)
+	{
+		if (!p_PCBs[i].started)
+		{
+			continue;
+		}
+		if (simulation.p_processBufferStart[i].remainingTime > 0)
+		{
+			struct PCB *p_PCB = restartProcess(simulation.processTable, PCB_sem, &p_PCBs[i].PCB);
+			if (i == p_checkpoint->scheduledProcess)
+			{
+				simulation.p_scheduledPCB = p_PCB;
+			}
+		}
+		else
+		{
+			simulation.processTable[i] = 0;
+		}
+	}
+
+	// statistics
+	struct checkpointStats *p_stats = (struct checkpointStats *) (p_file + p_checkpoint->statsOffset);
+	performance = p_stats->performance;
+	memoryCounters = p_stats->memoryCounters;
+	waitingProcessPool.allocations = p_stats->waitingProcessAllocations;
+	waitingProcessPool.mallocs = p_stats->waitingProcessMallocs;
+	memUnitPool.allocations = p_stats->memUnitAllocations;
+	memUnitPool.mallocs = p_stats->memUnitMallocs;
+
+	#if defined(TRACE_EXPORT) || defined(LIVE_METRICS)
+		simulation.arrivedProcesses = p_checkpoint->arrivedProcesses;
+	#endif
+	simulation.currentTime = p_checkpoint->time;
+	simulation.wastedTime = p_checkpoint->wastedTime;
+	simulation.processesFinished = p_checkpoint->processesFinished;
+	simulation.processQuantum = p_checkpoint->processQuantum;
+	simulation.p_scheduledProcess = (p_checkpoint->scheduledProcess != -1) ? (simulation.p_processBufferStart + p_checkpoint->scheduledProcess) : NULL;
+}
+
+void writeCheckpointPerformance(FILE *pFile)
+{
+	fprintf(pFile, "Checkpoints = %d written, %d skipped, every %d time steps\n", checkpoints.written, checkpoints.skipped, CHECKPOINT_INTERVAL);
+	fprintf(pFile, "Avg checkpoint stall = %.2f us\n", (checkpoints.written == 0) ? 0 : checkpoints.stallTime / checkpoints.written * 1e6);
+}
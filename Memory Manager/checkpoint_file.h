@@ -0,0 +1,82 @@
+// Checkpoint file format. A checkpoint is a single file that can be mapped as a whole: a header
+// with the scalars of the simulation followed by sections at the offsets given in the header.
+// The scheduler writes it (checkpoint.h), and the clock, the process generator and the scheduler
+// read it back when the OSSIM_RESUME environment variable names it.
+#include <sys/mman.h>
+#include <fcntl.h>
+
+#define CHECKPOINT_MAGIC "OSCKPT1\n"
+#define CHECKPOINT_FILE "checkpoint.bin"
+#define RESUME_VARIABLE "OSSIM_RESUME"
+
+// alignment of the sections
+#define CHECKPOINT_ALIGNMENT 64
+
+struct checkpointHeader
+{
+	char magic[8];
+	long size;			// file size
+	int N;				// total number of processes in simulation
+	int time;			// time step to resume at, before the processes of that time step arrive
+	int memorySize;
+	int processSize;		// sizes of struct process and struct PCB, to check the layout
+	int PCBSize;
+	int allocatorType;
+	int arrivedProcesses;
+	int processesFinished;
+	int wastedTime;
+	int processQuantum;
+	int scheduledProcess;		// index in the process buffer, -1 if no process is running
+	int memUnits;			// memory units in the buddy tree
+	int waitingProcesses;
+	int waitingSequence;
+	long logLength;			// lengths of scheduler.log and memory.log at the checkpoint
+	long memLogLength;
+	long sharedOffset;		// scheduler info, ready queue and process buffer
+	long sharedSize;
+	long PCBOffset;			// PCB of every process
+	long memoryOffset;		// buddy tree in preorder
+	long waitingOffset;		// waiting list by class, in list order
+	long statsOffset;		// performance statistics and counters
+};
+
+struct checkpointHeader *p_resumeCheckpoint = NULL;
+
+// maps the checkpoint named by OSSIM_RESUME and returns it, or NULL when not resuming
+struct checkpointHeader *resumeCheckpoint()
+{
+	char *path = getenv(RESUME_VARIABLE);
+	if ((p_resumeCheckpoint != NULL) || (path == NULL))
+	{
+		return p_resumeCheckpoint;
+	}
+	int fd = open(path, O_RDONLY);
+	struct stat fileStat;
+	if ((fd == -1) || (fstat(fd, &fileStat) == -1) || (fileStat.st_size < (long) sizeof(struct checkpointHeader)))
+	{
+		printf("Could not open checkpoint %s\n", path);
+		exit(-1);
+	}
+	struct checkpointHeader *p_checkpoint = (struct checkpointHeader *) mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if ((p_checkpoint == MAP_FAILED) || (memcmp(p_checkpoint->magic, CHECKPOINT_MAGIC, sizeof(p_checkpoint->magic)) != 0) || (p_checkpoint->size != fileStat.st_size))
+	{
+		printf("File %s is not a checkpoint\n", path);
+		exit(-1);
+	}
+	p_resumeCheckpoint = p_checkpoint;
+	return p_resumeCheckpoint;
+}
+
+// time step the clock starts at
+int resumeTime()
+{
+	return (resumeCheckpoint() != NULL) ? resumeCheckpoint()->time : 0;
+}
+
+// restores the memory shared between the generator and the scheduler
+void resumeShared(void *p_shared)
+{
+	struct checkpointHeader *p_checkpoint = resumeCheckpoint();
+	memcpy(p_shared, (char *) p_checkpoint + p_checkpoint->sharedOffset, p_checkpoint->sharedSize);
+}
@@ -6,6 +6,9 @@
  */
 
 #include "headers.h"
+#ifdef CHECKPOINT
+#include "checkpoint_file.h"
+#endif
 
 int shmid;
 
@@ -22,9 +25,13 @@ int main(int argc, char * argv[])
 {
     printf("Clock starting\n");
     signal(SIGINT, cleanup);
+#ifdef CHECKPOINT
+    int clk = resumeTime(); /* continue from a checkpoint */
+#else
     int clk = 0;
+#endif
     //Create shared memory for one integer variable 4 bytes
-    shmid = shmget(SHKEY, 4, IPC_CREAT | 0644);
+    shmid = shmget(ipcKey(SHKEY), 4, IPC_CREAT | 0644);
     if ((long)shmid == -1)
     {
         perror("Error in creating shm!");
@@ -0,0 +1,169 @@
+// Memory compaction. When a process does not fit in any free memory unit although the total
+// free memory is large enough, the resident processes are relocated so that they are packed
+// at the start of the memory (largest first) and the free memory is merged into large units.
+// The modelled time of a compaction delays the start of the process it was made for.
+
+// compaction cost model (can be overridden with -D)
+#ifndef COMPACTION_LATENCY_TICKS
+#define COMPACTION_LATENCY_TICKS 1
+#endif
+#ifndef COMPACTION_BYTES_PER_TICK
+#define COMPACTION_BYTES_PER_TICK 1024
+#endif
+
+struct compactionState
+{
+	struct process *p_processBufferStart;
+
+	// compaction ticks each process waits for before it runs, indexed by process index
+	int *ticksLeft;
+
+	// statistics
+	int compactions;
+	int moves;
+	long bytesMoved;
+	long ticks;
+};
+
+struct compactionState compaction;
+
+void initCompaction(int N, struct process *p_processBufferStart)
+{
+	compaction.p_processBufferStart = p_processBufferStart;
+	compaction.ticksLeft = (int *) calloc(N, sizeof(int));
+}
+
+// collects the resident processes in address order
+void collectResidents(struct memUnit *memory, struct process **residents, int *count)
+{
+	if ((memory->left == NULL) && (memory->right == NULL))
+	{
+		if (memory->id != EMPTY)
+		{
+			residents[(*count)++] = compaction.p_processBufferStart + memory->id - 1;
+		}
+		return;
+	}
+	collectResidents(memory->left, residents, count);
+	collectResidents(memory->right, residents, count);
+}
+
+// returns true if compacting the memory would let a process of the given size fit
+bool compactionNeeded(struct memUnit *memory, int allocationSize)
+{
+	// compaction relocates memory units of the buddy system only
+	if (allocatorType != BUDDY)
+	{
+		return false;
+	}
+	return (memory->largestFree < allocationSize) && (MEMORY_SIZE - memoryCounters.allocatedBytes >= allocationSize);
+}
+
+// compacts the memory and returns the modelled time of the compaction
+int compactMemory(FILE *pFile, int currentTime, struct memUnit *memory)
+{
+	struct process *residents[MEMORY_SIZE / SMALLEST_ALLOCATION_UNIT];
+	int oldStart[MEMORY_SIZE / SMALLEST_ALLOCATION_UNIT];
+	int count = 0;
+	collectResidents(memory, residents, &count);
+
+	// sort by allocation size (largest first), keeping the address order of equal sizes
+	for (int i = 1; i < count; i++)
+	{
+		for (int j = i; (j > 0) && (residents[j]->allocationSize > residents[j - 1]->allocationSize); j--)
+		{
+			struct process *p_process = residents[j];
+			residents[j] = residents[j - 1];
+			residents[j - 1] = p_process;
+		}
+	}
+
+	// free all processes then allocate them again in sorted order
+	for (int i = 0; i < count; i++)
+	{
+		oldStart[i] = residents[i]->allocatedMemUnit->start;
+		deallocate(residents[i]);
+	}
+	for (int i = 0; i < count; i++)
+	{
+		if (!allocate(memory, residents[i]))
+		{
+			splitAllocate(residents[i]);
+		}
+	}
+
+	#ifdef SWAPPING
+		// move the contents of the relocated processes
+		char oldImage[MEMORY_SIZE];
+		memcpy(oldImage, swap.memoryImage, MEMORY_SIZE);
+	#endif
+	int bytesMoved = 0;
+	for (int i = 0; i < count; i++)
+	{
+		struct process *p_process = residents[i];
+		int start = p_process->allocatedMemUnit->start;
+		if (start == oldStart[i])
+		{
+			continue;
+		}
+		#ifdef SWAPPING
+			memcpy(swap.memoryImage + start, oldImage + oldStart[i], p_process->allocationSize);
+		#endif
+		#ifdef TRACE_EXPORT
+			traceMemory(currentTime, "moved", p_process->id, p_process->memSize, oldStart[i], start);
+		#endif
+		#ifdef BINARY_LOG
+			logEvent(MEMORY_EVENT + MOVED, currentTime, p_process->id, p_process->memSize, oldStart[i], start, 0, 0);
+		#else
+			fprintf(pFile, "At time %d moved %d bytes of process %d from %d to %d\n", currentTime, p_process->memSize, p_process->id, oldStart[i], start);
+		#endif
+		#ifdef PRINTING
+			printf("Memory Manager: Process %d moved from %d to %d\n", p_process->id, oldStart[i], start);
+		#endif
+		#ifdef BACKFILLING
+			moveBackfillResident(p_process);
+		#endif
+		bytesMoved += p_process->allocationSize;
+		compaction.moves++;
+	}
+
+	int ticks = COMPACTION_LATENCY_TICKS + ((bytesMoved + COMPACTION_BYTES_PER_TICK - 1) / COMPACTION_BYTES_PER_TICK);
+	compaction.compactions++;
+	compaction.bytesMoved += bytesMoved;
+	compaction.ticks += ticks;
+	return ticks;
+}
+
+// compacts the memory if it lets the given process fit and returns true if it did
+bool compactFor(FILE *pFile, int currentTime, struct memUnit *memory, struct process *p_process)
+{
+	if (!compactionNeeded(memory, p_process->allocationSize))
+	{
+		return false;
+	}
+	compaction.ticksLeft[p_process->id - 1] += compactMemory(pFile, currentTime, memory);
+	return true;
+}
+
+// returns true if the scheduled process is still waiting for the compaction made for it, which takes one tick
+bool waitForCompaction(struct process *p_process)
+{
+	int processIndex = p_process->id - 1;
+	if (compaction.ticksLeft[processIndex] == 0)
+	{
+		return false;
+	}
+	compaction.ticksLeft[processIndex]--;
+	#ifdef PRINTING
+		printf("Scheduler: Process %d is waiting for compaction\n", p_process->id);
+	#endif
+	return true;
+}
+
+void writeCompactionPerformance(FILE *pFile)
+{
+	fprintf(pFile, "Compactions = %d\n", compaction.compactions);
+	fprintf(pFile, "Compaction moves = %d\n", compaction.moves);
+	fprintf(pFile, "Compaction bytes moved = %ld\n", compaction.bytesMoved);
+	fprintf(pFile, "Compaction time = %ld ticks\n", compaction.ticks);
+}
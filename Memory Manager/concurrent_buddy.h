@@ -0,0 +1,244 @@
+// Thread-safe buddy allocator. Free blocks are kept in one list per order, each with its own lock,
+// so threads allocating different sizes do not serialize on one structure. A block is split by
+// taking it from a larger order and returning the upper halves to the smaller orders, and a freed
+// block is merged with its buddy while the buddy is free, one order at a time, so no two locks are
+// ever held together. Each thread also keeps a magazine of free blocks for the small orders that is
+// refilled from and flushed to the lists in batches, so most small allocations take no lock.
+// Blocks are identified by their first unit (start / SMALLEST_ALLOCATION_UNIT).
+#include <pthread.h>
+
+// orders cached in the magazines and their capacity (can be overridden with -D)
+#ifndef MAGAZINE_ORDERS
+#define MAGAZINE_ORDERS 4
+#endif
+#ifndef MAGAZINE_SIZE
+#define MAGAZINE_SIZE 32
+#endif
+
+#define MAX_CONCURRENT_ORDERS 32
+
+struct concurrentBuddy
+{
+	int orders;
+	int units;
+	bool singleLock;	// one lock for all orders (for comparison)
+	bool magazines;
+	pthread_mutex_t locks[MAX_CONCURRENT_ORDERS];
+	int heads[MAX_CONCURRENT_ORDERS];
+
+	// free lists, indexed by unit
+	int *next;
+	int *prev;
+	unsigned char *freeOrder;	// order + 1 of the free block starting at the unit, 0 if none
+};
+
+struct concurrentBuddy concurrentBuddy;
+
+struct magazine
+{
+	int blocks[MAGAZINE_SIZE];
+	int count;
+};
+
+__thread struct magazine magazines[MAGAZINE_ORDERS];
+
+pthread_mutex_t *orderLock(int order)
+{
+	return &concurrentBuddy.locks[concurrentBuddy.singleLock ? 0 : order];
+}
+
+// list operations, called with the lock of the order held
+void pushFree(int order, int unit)
+{
+	concurrentBuddy.next[unit] = concurrentBuddy.heads[order];
+	concurrentBuddy.prev[unit] = -1;
+	if (concurrentBuddy.heads[order] != -1)
+	{
+		concurrentBuddy.prev[concurrentBuddy.heads[order]] = unit;
+	}
+	concurrentBuddy.heads[order] = unit;
+	__atomic_store_n(&concurrentBuddy.freeOrder[unit], order + 1, __ATOMIC_RELAXED);
+}
+
+void removeFree(int order, int unit)
+{
+	if (concurrentBuddy.prev[unit] != -1)
+	{
+		concurrentBuddy.next[concurrentBuddy.prev[unit]] = concurrentBuddy.next[unit];
+	}
+	else
+	{
+		concurrentBuddy.heads[order] = concurrentBuddy.next[unit];
+	}
+	if (concurrentBuddy.next[unit] != -1)
+	{
+		concurrentBuddy.prev[concurrentBuddy.next[unit]] = concurrentBuddy.prev[unit];
+	}
+	__atomic_store_n(&concurrentBuddy.freeOrder[unit], 0, __ATOMIC_RELAXED);
+}
+
+int popFree(int order)
+{
+	int unit = concurrentBuddy.heads[order];
+	if (unit != -1)
+	{
+		removeFree(order, unit);
+	}
+	return unit;
+}
+
+// the memory starts as one free block of the largest order
+void initConcurrentBuddy(int orders, bool singleLock, bool magazines)
+{
+	concurrentBuddy.orders = orders;
+	concurrentBuddy.units = 1 << (orders - 1);
+	concurrentBuddy.singleLock = singleLock;
+	concurrentBuddy.magazines = magazines;
+	concurrentBuddy.next = (int *) malloc(concurrentBuddy.units * sizeof(int));
+	concurrentBuddy.prev = (int *) malloc(concurrentBuddy.units * sizeof(int));
+	concurrentBuddy.freeOrder = (unsigned char *) calloc(concurrentBuddy.units, sizeof(unsigned char));
+	for (int order = 0; order < orders; order++)
+	{
+		pthread_mutex_init(&concurrentBuddy.locks[order], NULL);
+		concurrentBuddy.heads[order] = -1;
+	}
+	pushFree(orders - 1, 0);
+}
+
+void destroyConcurrentBuddy()
+{
+	for (int order = 0; order < concurrentBuddy.orders; order++)
+	{
+		pthread_mutex_destroy(&concurrentBuddy.locks[order]);
+	}
+	free(concurrentBuddy.next);
+	free(concurrentBuddy.prev);
+	free(concurrentBuddy.freeOrder);
+}
+
+int globalAllocate(int order)
+{
+	for (int splitOrder = order; splitOrder < concurrentBuddy.orders; splitOrder++)
+	{
+		pthread_mutex_lock(orderLock(splitOrder));
+		int unit = popFree(splitOrder);
+		pthread_mutex_unlock(orderLock(splitOrder));
+		if (unit != -1)
+		{
+			// return the upper halves to the smaller orders
+			while (splitOrder > order)
+			{
+				splitOrder--;
+				pthread_mutex_lock(orderLock(splitOrder));
+				pushFree(splitOrder, unit + (1 << splitOrder));
+				pthread_mutex_unlock(orderLock(splitOrder));
+			}
+			return unit;
+		}
+	}
+	return -1;
+}
+
+// takes up to count blocks of the order, with one lock for the blocks that are already free
+int globalAllocateBatch(int order, int *units, int count)
+{
+	int allocated = 0;
+	pthread_mutex_lock(orderLock(order));
+	while (allocated < count)
+	{
+		int unit = popFree(order);
+		if (unit == -1)
+		{
+			break;
+		}
+		units[allocated++] = unit;
+	}
+	pthread_mutex_unlock(orderLock(order));
+
+	while (allocated < count)
+	{
+		int unit = globalAllocate(order);
+		if (unit == -1)
+		{
+			break;
+		}
+		units[allocated++] = unit;
+	}
+	return allocated;
+}
+
+// frees blocks of the order with one lock per order: blocks whose buddy is free are merged and
+// carried to the next order, the others are added to the list
+void globalFreeBatch(int order, int *units, int count)
+{
+	while (count > 0)
+	{
+		int merged = 0;
+		pthread_mutex_lock(orderLock(order));
+		for (int i = 0; i < count; i++)
+		{
+			int buddy = units[i] ^ (1 << order);
+			if ((order < concurrentBuddy.orders - 1) && (__atomic_load_n(&concurrentBuddy.freeOrder[buddy], __ATOMIC_RELAXED) == order + 1))
+			{
+				removeFree(order, buddy);
+				units[merged++] = units[i] & ~(1 << order);
+			}
+			else
+			{
+				pushFree(order, units[i]);
+			}
+		}
+		pthread_mutex_unlock(orderLock(order));
+		count = merged;
+		order++;
+	}
+}
+
+int concurrentAllocate(int order)
+{
+	if (concurrentBuddy.magazines && (order < MAGAZINE_ORDERS))
+	{
+		struct magazine *p_magazine = &magazines[order];
+		if (p_magazine->count == 0)
+		{
+			p_magazine->count = globalAllocateBatch(order, p_magazine->blocks, MAGAZINE_SIZE / 2);
+			if (p_magazine->count == 0)
+			{
+				return -1;
+			}
+		}
+		return p_magazine->blocks[--p_magazine->count];
+	}
+	return globalAllocate(order);
+}
+
+void concurrentDeallocate(int unit, int order)
+{
+	if (concurrentBuddy.magazines && (order < MAGAZINE_ORDERS))
+	{
+		struct magazine *p_magazine = &magazines[order];
+		if (p_magazine->count == MAGAZINE_SIZE)
+		{
+			// flush the older half
+			globalFreeBatch(order, p_magazine->blocks, MAGAZINE_SIZE / 2);
+			for (int i = 0; i < MAGAZINE_SIZE / 2; i++)
+			{
+				p_magazine->blocks[i] = p_magazine->blocks[i + MAGAZINE_SIZE / 2];
+			}
+			p_magazine->count -= MAGAZINE_SIZE / 2;
+		}
+		p_magazine->blocks[p_magazine->count++] = unit;
+		return;
+	}
+	globalFreeBatch(order, &unit, 1);
+}
+
+// returns the blocks cached by the calling thread, which must be done before the thread exits
+void flushMagazines()
+{
+	for (int order = 0; order < MAGAZINE_ORDERS; order++)
+	{
+		globalFreeBatch(order, magazines[order].blocks, magazines[order].count);
+		magazines[order].count = 0;
+	}
+}
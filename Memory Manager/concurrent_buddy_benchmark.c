@@ -0,0 +1,123 @@
+#include "headers.h"
+#include "scheduler_utilities.h"
+#include "concurrent_buddy.h"
+#include <time.h>
+
+// thread counts to benchmark
+#define THREAD_COUNTS 7
+int threadCounts[THREAD_COUNTS] = {1, 2, 4, 8, 16, 32, 64};
+
+// 8 MiB of memory in units of SMALLEST_ALLOCATION_UNIT
+#define BENCHMARK_ORDERS 21
+
+// blocks held by each thread and operations per thread
+#define SLOTS 256
+#define OPERATIONS 100000
+
+// allocator configurations
+#define CONFIGURATIONS 3
+char *configurationNames[CONFIGURATIONS] = {"single lock", "order locks", "magazines"};
+
+struct slot
+{
+	int unit;
+	int order;
+};
+
+struct threadResult
+{
+	int thread;
+	long operations;
+	long failed;
+};
+
+double getTime()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// random allocations and frees over a set of slots, mostly of the small sizes
+void *churn(void *p_arg)
+{
+	struct threadResult *p_result = (struct threadResult *) p_arg;
+	struct slot slots[SLOTS];
+	for (int i = 0; i < SLOTS; i++)
+	{
+		slots[i].unit = -1;
+	}
+	unsigned int seed = p_result->thread + 1;
+	for (int i = 0; i < OPERATIONS; i++)
+	{
+		struct slot *p_slot = &slots[rand_r(&seed) % SLOTS];
+		if (p_slot->unit != -1)
+		{
+			concurrentDeallocate(p_slot->unit, p_slot->order);
+			p_slot->unit = -1;
+		}
+		else
+		{
+			int size = (rand_r(&seed) % 10 < 8) ? (rand_r(&seed) % 64 + 1) : (rand_r(&seed) % 1024 + 1);
+			p_slot->order = allocationOrder(size);
+			p_slot->unit = concurrentAllocate(p_slot->order);
+			if (p_slot->unit == -1)
+			{
+				p_result->failed++;
+			}
+		}
+		p_result->operations++;
+	}
+
+	// free everything
+	for (int i = 0; i < SLOTS; i++)
+	{
+		if (slots[i].unit != -1)
+		{
+			concurrentDeallocate(slots[i].unit, slots[i].order);
+		}
+	}
+	flushMagazines();
+	return NULL;
+}
+
+int main(int argc, char * argv[])
+{
+	printf("%-8s %-12s %-12s %-10s %-6s\n", "threads", "allocator", "Mops/s", "failed", "merged");
+	for (int t = 0; t < THREAD_COUNTS; t++)
+	{
+		for (int configuration = 0; configuration < CONFIGURATIONS; configuration++)
+		{
+			initConcurrentBuddy(BENCHMARK_ORDERS, configuration == 0, configuration == 2);
+			pthread_t threads[threadCounts[t]];
+			struct threadResult results[threadCounts[t]];
+			double start = getTime();
+			for (int i = 0; i < threadCounts[t]; i++)
+			{
+				results[i].thread = i;
+				results[i].operations = 0;
+				results[i].failed = 0;
+				pthread_create(&threads[i], NULL, churn, &results[i]);
+			}
+			long operations = 0;
+			long failed = 0;
+			for (int i = 0; i < threadCounts[t]; i++)
+			{
+				pthread_join(threads[i], NULL);
+				operations += results[i].operations;
+				failed += results[i].failed;
+			}
+			double elapsed = getTime() - start;
+
+			// all blocks were freed, so the memory must have merged back into one block
+			bool merged = (concurrentBuddy.heads[BENCHMARK_ORDERS - 1] == 0);
+			for (int order = 0; order < BENCHMARK_ORDERS - 1; order++)
+			{
+				merged = merged && (concurrentBuddy.heads[order] == -1);
+			}
+			printf("%-8d %-12s %-12.2f %-10ld %-6s\n", threadCounts[t], configurationNames[configuration], operations / elapsed * 1e-6, failed, merged ? "yes" : "no");
+			destroyConcurrentBuddy();
+		}
+	}
+	return 0;
+}
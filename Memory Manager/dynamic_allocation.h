@@ -0,0 +1,357 @@
+// Dynamic allocation requests. While it runs, a process submits a batch of malloc/free requests
+// once per time step through a ring in its PCB: a Poisson number of requests with the rate of the
+// process, with exponentially distributed sizes around its mean request size. The memory manager
+// services the batches at the start of the next time step. A malloc that cannot be met blocks the
+// process: the scheduler stops it and takes it out of the ready queue (blockProcess() in
+// simulation.h). The requests of blocked processes are retried first every time step, and a
+// process whose requests are met is enqueued again. When no process is left to run and free
+// memory, the mallocs of the earliest blocked process fail as they would when memory is exhausted.
+#include <time.h>
+
+// blocks a process can hold at the same time and the largest request
+#define BLOCKS_PER_PROCESS 16
+#define MAX_REQUEST_SIZE 256
+
+// request rate and mean request size of processes that do not give them (can be overridden with -D)
+#ifndef DEFAULT_REQUEST_RATE
+#define DEFAULT_REQUEST_RATE 2
+#endif
+#ifndef DEFAULT_REQUEST_SIZE
+#define DEFAULT_REQUEST_SIZE 16
+#endif
+
+struct dynamicAllocation
+{
+	// blocks of each process, indexed by process index * BLOCKS_PER_PROCESS + handle
+	struct process *blocks;
+
+	// processes with a request that could not be met, in the order they blocked
+	struct PCB **blockedPCBs;
+	bool *blocked;
+	int *blockedSince;
+	int blockedCount;
+
+	// called when a block is allocated (delta 1) or before it is freed (delta -1), if set
+	void (*blockChanged)(struct process *p_block, int delta);
+
+	// statistics
+	long mallocs;
+	long frees;
+	long failedMallocs;
+	long deniedMallocs;
+	long blockedTime;
+	int batches;
+	int largestBatch;
+	long nanoseconds;
+};
+
+struct dynamicAllocation dynamicAllocation;
+
+// process side: blocks held by the process and the start of its last batch
+struct requestGenerator
+{
+	int handles[BLOCKS_PER_PROCESS];
+	int held;
+	int batchStart;
+	int lastTime;
+	unsigned int seed;
+};
+
+void initDynamicAllocation(int N)
+{
+	dynamicAllocation.blocks = (struct process *) calloc(N * BLOCKS_PER_PROCESS, sizeof(struct process));
+	for (int i = 0; i < N * BLOCKS_PER_PROCESS; i++)
+	{
+		// block ids follow the process ids
+		dynamicAllocation.blocks[i].id = N + 1 + i;
+	}
+	dynamicAllocation.blockedPCBs = (struct PCB **) malloc(N * sizeof(struct PCB *));
+	dynamicAllocation.blocked = (bool *) calloc(N, sizeof(bool));
+	dynamicAllocation.blockedSince = (int *) calloc(N, sizeof(int));
+	dynamicAllocation.blockedCount = 0;
+}
+
+long getRequestNanoseconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+void writeBlockLog(FILE *pFile, int currentTime, int processId, int handle, struct process *p_block, int logType)
+{
+	HOT_PATH_TIMER(LOG_WRITE_OPERATION);
+	#ifdef TRACE_EXPORT
+		traceMemory(currentTime, (logType == ALLOCATED) ? "block allocated" : "block freed", processId, p_block->memSize, p_block->allocatedMemUnit->start, p_block->allocatedMemUnit->start + p_block->allocationSize - 1);
+	#endif
+	#ifdef BINARY_LOG
+		logEvent(MEMORY_EVENT + ((logType == ALLOCATED) ? BLOCK_ALLOCATED : BLOCK_FREED), currentTime, processId, p_block->memSize, p_block->allocatedMemUnit->start, p_block->allocatedMemUnit->start + p_block->allocationSize - 1, handle, 0);
+		return;
+	#endif
+	switch (logType)
+	{
+		case ALLOCATED:
+			fprintf(pFile, "At time %d allocated %d bytes for process %d block %d from %d to %d\n", currentTime, p_block->memSize, processId, handle, p_block->allocatedMemUnit->start, p_block->allocatedMemUnit->start + p_block->allocationSize - 1);
+			break;
+
+		case FREED:
+			fprintf(pFile, "At time %d freed %d bytes from process %d block %d from %d to %d\n", currentTime, p_block->memSize, processId, handle, p_block->allocatedMemUnit->start, p_block->allocatedMemUnit->start + p_block->allocationSize - 1);
+			break;
+	}
+}
+
+// services the pending requests of a process in order and returns false if it is blocked
+bool serviceRequests(FILE *pFile, int currentTime, struct memUnit *memory, struct PCB *p_PCB, int *serviced)
+{
+	struct process *p_blocks = dynamicAllocation.blocks + (p_PCB->id - 1) * BLOCKS_PER_PROCESS;
+	int head = p_PCB->requestHead;
+	int tail = __atomic_load_n(&p_PCB->requestTail, __ATOMIC_ACQUIRE);
+	while (head != tail)
+	{
+		struct allocationRequest *p_request = &p_PCB->requests[head % REQUEST_RING_SIZE];
+		if (p_request->type == FREE)
+		{
+			struct process *p_block = p_blocks + p_request->block;
+			writeBlockLog(pFile, currentTime, p_PCB->id, p_request->block, p_block, FREED);
+			if (dynamicAllocation.blockChanged != NULL)
+			{
+				dynamicAllocation.blockChanged(p_block, -1);
+			}
+			deallocate(p_block);
+			dynamicAllocation.frees++;
+		}
+		else
+		{
+			// the process never holds more than BLOCKS_PER_PROCESS blocks, so a handle is free
+			int handle = 0;
+			while (p_blocks[handle].allocatedMemUnit != NULL)
+			{
+				handle++;
+			}
+			struct process *p_block = p_blocks + handle;
+			p_block->memSize = p_request->size;
+			p_block->allocationSize = allocationSizeFor(p_request->size);
+			bool blockAllocated = mayFit(memory, p_block->allocationSize) && allocate(memory, p_block);
+			if (!blockAllocated && (p_block->allocatedMemUnit != NULL))
+			{
+				splitAllocate(p_block);
+				blockAllocated = true;
+			}
+			if (!blockAllocated)
+			{
+				dynamicAllocation.failedMallocs++;
+				break;
+			}
+			p_request->block = handle;
+			writeBlockLog(pFile, currentTime, p_PCB->id, handle, p_block, ALLOCATED);
+			if (dynamicAllocation.blockChanged != NULL)
+			{
+				dynamicAllocation.blockChanged(p_block, 1);
+			}
+			dynamicAllocation.mallocs++;
+		}
+		head++;
+		(*serviced)++;
+	}
+	__atomic_store_n(&p_PCB->requestHead, head, __ATOMIC_RELEASE);
+	return head == tail;
+}
+
+void unblockProcess(int currentTime, struct PCB *p_PCB, struct readyQueue *p_readyQueue, struct process *p_processBufferStart, int schedulerType)
+{
+	dynamicAllocation.blocked[p_PCB->id - 1] = false;
+	dynamicAllocation.blockedTime += currentTime - dynamicAllocation.blockedSince[p_PCB->id - 1];
+	enqueue(p_readyQueue, p_processBufferStart, p_processBufferStart + (p_PCB->id - 1), p_PCB->id - 1, schedulerType);
+	p_readyQueue->processArrival = true;
+	#ifdef PRINTING
+		printf("Memory Manager: Process %d unblocked\n", p_PCB->id);
+	#endif
+}
+
+// services the requests of the blocked processes and then the batch of the process that ran during
+// the last time step, the processes that are no longer blocked are enqueued in the ready queue
+void serviceAllocationRequests(FILE *pFile, int currentTime, struct memUnit *memory, struct PCB *p_ranPCB, struct readyQueue *p_readyQueue, struct process *p_processBufferStart, int schedulerType)
+{
+	long startTime = getRequestNanoseconds();
+	int serviced = 0;
+
+	int stillBlocked = 0;
+	for (int i = 0; i < dynamicAllocation.blockedCount; i++)
+	{
+		struct PCB *p_PCB = dynamicAllocation.blockedPCBs[i];
+		if (serviceRequests(pFile, currentTime, memory, p_PCB, &serviced))
+		{
+			unblockProcess(currentTime, p_PCB, p_readyQueue, p_processBufferStart, schedulerType);
+		}
+		else
+		{
+			dynamicAllocation.blockedPCBs[stillBlocked++] = p_PCB;
+		}
+	}
+	dynamicAllocation.blockedCount = stillBlocked;
+
+	if ((p_ranPCB != NULL) && !dynamicAllocation.blocked[p_ranPCB->id - 1] && !serviceRequests(pFile, currentTime, memory, p_ranPCB, &serviced))
+	{
+		dynamicAllocation.blocked[p_ranPCB->id - 1] = true;
+		dynamicAllocation.blockedSince[p_ranPCB->id - 1] = currentTime;
+		dynamicAllocation.blockedPCBs[dynamicAllocation.blockedCount++] = p_ranPCB;
+		#ifdef PRINTING
+			printf("Memory Manager: Process %d blocked on a request\n", p_ranPCB->id);
+		#endif
+	}
+
+	if (serviced > 0)
+	{
+		dynamicAllocation.batches++;
+		if (serviced > dynamicAllocation.largestBatch)
+		{
+			dynamicAllocation.largestBatch = serviced;
+		}
+	}
+	dynamicAllocation.nanoseconds += getRequestNanoseconds() - startTime;
+}
+
+// fails the mallocs of the earliest blocked process that cannot be met, as malloc returns NULL when
+// memory is exhausted, and enqueues it again. Called when no process can run to free memory for it.
+void denyBlockedRequests(FILE *pFile, int currentTime, struct memUnit *memory, struct readyQueue *p_readyQueue, struct process *p_processBufferStart, int schedulerType)
+{
+	struct PCB *p_PCB = dynamicAllocation.blockedPCBs[0];
+	int serviced = 0;
+	while (!serviceRequests(pFile, currentTime, memory, p_PCB, &serviced))
+	{
+		// the request at the head of the ring is the malloc that could not be met
+		int head = p_PCB->requestHead;
+		p_PCB->requests[head % REQUEST_RING_SIZE].block = -1;
+		__atomic_store_n(&p_PCB->requestHead, head + 1, __ATOMIC_RELEASE);
+		dynamicAllocation.deniedMallocs++;
+	}
+	dynamicAllocation.blockedCount--;
+	for (int i = 0; i < dynamicAllocation.blockedCount; i++)
+	{
+		dynamicAllocation.blockedPCBs[i] = dynamicAllocation.blockedPCBs[i + 1];
+	}
+	#ifdef PRINTING
+		printf("Memory Manager: Memory exhausted, mallocs of process %d failed\n", p_PCB->id);
+	#endif
+	unblockProcess(currentTime, p_PCB, p_readyQueue, p_processBufferStart, schedulerType);
+}
+
+// frees the blocks a finished process still holds
+void releaseBlocks(FILE *pFile, int currentTime, struct process *p_process)
+{
+	int processIndex = p_process->id - 1;
+	struct process *p_blocks = dynamicAllocation.blocks + processIndex * BLOCKS_PER_PROCESS;
+	for (int handle = 0; handle < BLOCKS_PER_PROCESS; handle++)
+	{
+		if (p_blocks[handle].allocatedMemUnit != NULL)
+		{
+			writeBlockLog(pFile, currentTime, p_process->id, handle, p_blocks + handle, FREED);
+			if (dynamicAllocation.blockChanged != NULL)
+			{
+				dynamicAllocation.blockChanged(p_blocks + handle, -1);
+			}
+			deallocate(p_blocks + handle);
+		}
+	}
+
+	if (dynamicAllocation.blocked[processIndex])
+	{
+		// blocked on its last time step
+		dynamicAllocation.blocked[processIndex] = false;
+		int stillBlocked = 0;
+		for (int i = 0; i < dynamicAllocation.blockedCount; i++)
+		{
+			if (dynamicAllocation.blockedPCBs[i]->id != p_process->id)
+			{
+				dynamicAllocation.blockedPCBs[stillBlocked++] = dynamicAllocation.blockedPCBs[i];
+			}
+		}
+		dynamicAllocation.blockedCount = stillBlocked;
+	}
+}
+
+void initRequestGenerator(struct requestGenerator *p_generator, unsigned int seed)
+{
+	p_generator->held = 0;
+	p_generator->batchStart = 0;
+	p_generator->lastTime = -1;
+	p_generator->seed = seed;
+}
+
+double uniformRandom(unsigned int *p_seed)
+{
+	return (rand_r(p_seed) + 1.0) / (RAND_MAX + 1.0);
+}
+
+// submits a batch of requests once per time step while the process is running and its last batch was serviced
+void submitRequests(struct PCB *p_PCB, struct requestGenerator *p_generator, int currentTime)
+{
+	if ((p_PCB->state != RUNNING) || (p_PCB->requestSize == 0) || (currentTime == p_generator->lastTime))
+	{
+		return;
+	}
+	int head = __atomic_load_n(&p_PCB->requestHead, __ATOMIC_ACQUIRE);
+	if (head != p_PCB->requestTail)
+	{
+		// blocked
+		return;
+	}
+	p_generator->lastTime = currentTime;
+
+	// keep the handles of the blocks allocated in the last batch
+	for (int i = p_generator->batchStart; i != head; i++)
+	{
+		struct allocationRequest *p_request = &p_PCB->requests[i % REQUEST_RING_SIZE];
+		if ((p_request->type == MALLOC) && (p_request->block != -1)) // -1 if the malloc failed
+		{
+			p_generator->handles[p_generator->held++] = p_request->block;
+		}
+	}
+	p_generator->batchStart = head;
+
+	// Poisson number of requests
+	int count = 0;
+	double limit = exp(-p_PCB->requestRate);
+	for (double product = uniformRandom(&p_generator->seed); (product > limit) && (count < REQUEST_RING_SIZE); product *= uniformRandom(&p_generator->seed))
+	{
+		count++;
+	}
+
+	int tail = head;
+	int pendingMallocs = 0;
+	for (int i = 0; i < count; i++)
+	{
+		struct allocationRequest *p_request = &p_PCB->requests[tail % REQUEST_RING_SIZE];
+		if ((p_generator->held > 0) && (((p_generator->held + pendingMallocs) == BLOCKS_PER_PROCESS) || (rand_r(&p_generator->seed) % 2 == 0)))
+		{
+			// free a random block
+			int j = rand_r(&p_generator->seed) % p_generator->held;
+			p_request->type = FREE;
+			p_request->block = p_generator->handles[j];
+			p_generator->handles[j] = p_generator->handles[--p_generator->held];
+		}
+		else if ((p_generator->held + pendingMallocs) < BLOCKS_PER_PROCESS)
+		{
+			// exponentially distributed size
+			int size = 1 + (int) (-(p_PCB->requestSize - 1) * log(uniformRandom(&p_generator->seed)));
+			p_request->type = MALLOC;
+			p_request->size = (size > MAX_REQUEST_SIZE) ? MAX_REQUEST_SIZE : size;
+			pendingMallocs++;
+		}
+		else
+		{
+			break;
+		}
+		tail++;
+	}
+	__atomic_store_n(&p_PCB->requestTail, tail, __ATOMIC_RELEASE);
+}
+
+void writeDynamicAllocationPerformance(FILE *pFile)
+{
+	long requests = dynamicAllocation.mallocs + dynamicAllocation.frees;
+	fprintf(pFile, "Dynamic allocation requests: %ld mallocs, %ld frees, %ld failed mallocs, %ld denied when memory was exhausted\n", dynamicAllocation.mallocs, dynamicAllocation.frees, dynamicAllocation.failedMallocs, dynamicAllocation.deniedMallocs);
+	fprintf(pFile, "Request batches = %d (avg %.2f, max %d requests)\n", dynamicAllocation.batches, (dynamicAllocation.batches == 0) ? 0 : requests / (float) dynamicAllocation.batches, dynamicAllocation.largestBatch);
+	fprintf(pFile, "Blocked time = %ld process time steps (stopped until the request was met)\n", dynamicAllocation.blockedTime);
+	fprintf(pFile, "Avg request service time = %.2f ns\n", (requests == 0) ? 0 : dynamicAllocation.nanoseconds / (double) requests);
+}
@@ -0,0 +1,87 @@
+#include "headers.h"
+#include "simulation.h"
+#include "generator.h"
+#include "engine.h"
+#include <time.h>
+
+// Runs a simulation in one process with the in-process engine:
+//   ./ossim.out WORKLOAD [ALLOCATOR [ALGORITHM [QUANTUM]]]
+// with the same arguments and logs as the process generator.
+int main(int argc, char * argv[])
+{
+	if (argc < 2)
+	{
+		printf("Usage: %s WORKLOAD [ALLOCATOR [ALGORITHM [QUANTUM]]]\n", argv[0]);
+		return -1;
+	}
+
+	// select the memory allocator (buddy system by default)
+	int allocator = BUDDY;
+	if (argc > 2)
+	{
+		allocator = allocatorFromName(argv[2]);
+		if (allocator == -1)
+		{
+			printf("Unknown allocator %s (buddy, first-fit, best-fit, next-fit, tlsf or buddy-slab)\n", argv[2]);
+			return -1;
+		}
+	}
+	allocatorType = allocator;
+
+	// select the scheduling algorithm and quantum (asked otherwise)
+	int type = -1;
+	int quantum = 0;
+	if (argc > 3)
+	{
+		type = schedulerFromName(argv[3]);
+		if (type == -1)
+		{
+			printf("Unknown scheduling algorithm %s (hpf, srtn or rr)\n", argv[3]);
+			return -1;
+		}
+		if (type == RR)
+		{
+			quantum = (argc > 4) ? atoi(argv[4]) : 0;
+			if (quantum < 1)
+			{
+				printf("Round robin needs a quantum of at least 1\n");
+				return -1;
+			}
+		}
+	}
+
+	// read the workload
+	int N = 0;
+	struct process *processArray = readWorkload(argv[1], &N);
+	if (processArray == NULL)
+	{
+		return -1;
+	}
+
+	// ask the user for the chosen algorithm
+	if (type == -1)
+	{
+		printf("Choose a scheduling algorithm (0:HPF 1:SRTN 2:RR): ");
+		scanf("%d", &type);
+		if (type == RR)
+		{
+			printf("Determine a quantum value: ");
+			scanf("%d", &quantum);
+		}
+	}
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	int timeSteps = runEngine(processArray, N, type, quantum, allocator);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	if (timeSteps == -1)
+	{
+		free(processArray);
+		return -1;
+	}
+	double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+	printf("Simulated %d processes in %d time steps in %.3f s (%.0f time steps/s)\n", N, timeSteps, seconds, timeSteps / seconds);
+
+	free(processArray);
+	return 0;
+}
@@ -0,0 +1,104 @@
+// In-process engine. Runs the generator, the clock, the scheduler, the memory manager and the
+// processes of a simulation as modules of one process over plain memory (build with IN_PROCESS):
+// the clock is a counter, the ready queue and the process buffer are allocated instead of shared,
+// no process is forked and the running process is run by the engine for one time step after every
+// scheduling step. The logs are the same as those of the simulation over IPC, but the engine does
+// not wait for a clock, so it can be called from a benchmark driver.
+
+#ifndef IN_PROCESS
+#error "engine.h needs IN_PROCESS"
+#endif
+
+#ifdef DYNAMIC_ALLOCATION
+// request generators of the processes
+struct requestGenerator *requestGenerators;
+#endif
+
+// runs the process that is scheduled for one time step, as process.out does while it runs
+void runProcess(int currentTime)
+{
+	struct PCB *p_PCB = simulation.p_scheduledPCB;
+	if ((simulation.p_scheduledProcess == NULL) || (p_PCB->remainingTime <= 0))
+	{
+		return;
+	}
+	#if !defined(REAL_MEMORY) && !defined(DYNAMIC_ALLOCATION)
+		(void) currentTime;
+	#endif
+	#ifdef REAL_MEMORY
+		// touch the allocated range of the real memory
+		if (p_PCB->memorySize > 0)
+		{
+			unsigned int seed = p_PCB->id + currentTime;
+			touchRealMemory(simulation.p_realMemory, p_PCB->memoryStart, p_PCB->memorySize, &seed);
+		}
+	#endif
+	#ifdef DYNAMIC_ALLOCATION
+		submitRequests(p_PCB, &requestGenerators[p_PCB->id - 1], currentTime);
+	#endif
+}
+
+// simulates the processes (in arrival order) to completion with the given scheduling algorithm,
+// quantum and allocator, writes the logs and returns the number of time steps simulated
+int runEngine(struct process *processArray, int N, int schedulerType, int quantum, int allocator)
+{
+	// memory shared between the generator and the scheduler in the simulation over IPC (zeroed,
+	// since unused process buffer entries mark the processes that did not arrive yet)
+	struct schedulerInfo *p_schedulerInfo = (struct schedulerInfo *) calloc(1, SHARED_MEMORY_SIZE(N));
+	struct readyQueue *p_readyQueue = (struct readyQueue *) (p_schedulerInfo + 1);
+	struct process *p_processBufferStart = sharedProcessBuffer(p_schedulerInfo);
+	allocatorType = allocator;
+	initSchedulerInfo(p_schedulerInfo, N);
+	p_schedulerInfo->schedulerType = schedulerType;
+	p_schedulerInfo->quantum = quantum;
+	int currentTime = 0;
+	int processIndex = 0;
+	#ifdef CHECKPOINT
+		// continue from a checkpoint of the same workload, with its algorithm and quantum
+		struct checkpointHeader *p_checkpoint = resumeCheckpoint();
+		if (p_checkpoint != NULL)
+		{
+			if (p_checkpoint->N != N)
+			{
+				printf("The checkpoint does not match the workload\n");
+				free(p_schedulerInfo);
+				return -1;
+			}
+			resumeShared(p_schedulerInfo);
+			processIndex = p_checkpoint->arrivedProcesses;
+			currentTime = p_checkpoint->time;
+		}
+	#endif
+	
+	#ifdef DYNAMIC_ALLOCATION
+		requestGenerators = (struct requestGenerator *) malloc(N * sizeof(struct requestGenerator));
+		for (int i = 0; i < N; i++)
+		{
+			initRequestGenerator(&requestGenerators[i], processArray[i].id);
+		}
+	#endif
+	
+	// engine main loop: one iteration per time step
+	initSimulation(p_schedulerInfo, p_readyQueue, p_processBufferStart, N, currentTime);
+	while (simulation.processesFinished != N)
+	{
+		generateArrivals(p_schedulerInfo, processArray, N, &processIndex, currentTime);
+		stepSimulation();
+		runProcess(currentTime);
+		#ifdef CHECKPOINT
+			checkpointSimulation();
+		#endif
+		currentTime++;
+		advanceSimulation(currentTime);
+	}
+	finishSimulation();
+	int timeSteps = simulation.currentTime;
+	
+	// free dynamically allocated memory
+	destroySimulation();
+	#ifdef DYNAMIC_ALLOCATION
+		free(requestGenerators);
+	#endif
+	free(p_schedulerInfo);
+	return timeSteps;
+}
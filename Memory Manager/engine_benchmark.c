@@ -0,0 +1,95 @@
+#include "headers.h"
+#include "simulation.h"
+#include "generator.h"
+#include "engine.h"
+#include <time.h>
+
+// test cases to replay
+#define TEST_CASES 5
+#define TEST_CASE_PATH "../Test Cases/Memory Manager Test Cases/processes%d.txt"
+
+// generated traces (shorter running times than test_generator.c, so that the CPU load stays below
+// one and the ready queue does not grow with the trace)
+#define GENERATED_TRACES 2
+int generatedSizes[GENERATED_TRACES] = {10000, 1000000};
+
+// round robin quantum
+#define BENCHMARK_QUANTUM 4
+
+// the logs of the benchmark runs are written as scheduler.99.log and so on, and removed
+#define BENCHMARK_INSTANCE 99
+
+double getTime()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+struct process *generateTrace(int N)
+{
+	struct process *processes = (struct process *) malloc(N * sizeof(struct process));
+	srand(N);
+	int arrivalTime = 1;
+	for (int i = 0; i < N; i++)
+	{
+		arrivalTime += rand() % 8;
+		processes[i].id = i + 1;
+		processes[i].arrivalTime = arrivalTime;
+		processes[i].runningTime = rand() % 5 + 1;
+		processes[i].priority = rand() % 11;
+		processes[i].memSize = rand() % 255 + 1;
+		processes[i].remainingTime = processes[i].runningTime;
+		processes[i].allocationSize = allocationSizeFor(processes[i].memSize);
+		processes[i].allocatedMemUnit = NULL;
+		processes[i].next = -1;
+		processes[i].prev = -1;
+	}
+	return processes;
+}
+
+// runs a trace with every scheduling algorithm through the engine
+void runTrace(char *name, struct process *processes, int N)
+{
+	char *schedulerNames[] = {"hpf", "srtn", "rr"};
+	for (int type = HPF; type <= RR; type++)
+	{
+		double start = getTime();
+		int timeSteps = runEngine(processes, N, type, BENCHMARK_QUANTUM, BUDDY);
+		double seconds = getTime() - start;
+		printf("%-16s %-6s %-10d %-12d %-10.3f %-14.0f %-12.0f\n", name, schedulerNames[type], N, timeSteps, seconds, timeSteps / seconds, N / seconds);
+	}
+	remove(instancePath(LOG));
+	remove(instancePath(MEMORY));
+	remove(instancePath(PERFORMANCE));
+}
+
+int main(int argc, char * argv[])
+{
+	instance = BENCHMARK_INSTANCE;
+	printf("%-16s %-6s %-10s %-12s %-10s %-14s %-12s\n", "trace", "alg", "processes", "time steps", "seconds", "time steps/s", "processes/s");
+	for (int t = 1; t <= TEST_CASES; t++)
+	{
+		char path[64];
+		char name[16];
+		int N;
+		sprintf(path, TEST_CASE_PATH, t);
+		sprintf(name, "processes%d", t);
+		struct process *processes = readWorkload(path, &N);
+		if (processes == NULL)
+		{
+			continue;
+		}
+		runTrace(name, processes, N);
+		free(processes);
+	}
+	for (int t = 0; t < GENERATED_TRACES; t++)
+	{
+		char name[16];
+		sprintf(name, "generated%d", generatedSizes[t]);
+		struct process *processes = generateTrace(generatedSizes[t]);
+		runTrace(name, processes, generatedSizes[t]);
+		free(processes);
+	}
+	return 0;
+}
@@ -0,0 +1,94 @@
+#include "headers.h"
+#include "scheduler_utilities.h"
+
+// events read at a time
+#define DECODE_BATCH 4096
+
+void decodeSchedulerEvent(FILE *pFile, struct logEvent *p_event)
+{
+	char *states[] = {"started", "stopped", "finished", "resumed"};
+	fprintf(pFile, "At time %d process %d %s arr %d total %d remain %d wait %d", p_event->time, p_event->id, states[p_event->type], p_event->fields[0], p_event->fields[1], p_event->fields[2], p_event->fields[3]);
+	if (p_event->type == FINISHED)
+	{
+		fprintf(pFile, " TA %d WTA %.2f", (p_event->time - p_event->fields[0]), ((p_event->time - p_event->fields[0]) / (float) p_event->fields[1]));
+	}
+	fprintf(pFile, "\n");
+}
+
+void decodeMemoryEvent(FILE *pFile, struct logEvent *p_event)
+{
+	int *fields = p_event->fields;
+	switch (p_event->type - MEMORY_EVENT)
+	{
+		case ALLOCATED:
+			fprintf(pFile, "At time %d allocated %d bytes for process %d from %d to %d\n", p_event->time, fields[0], p_event->id, fields[1], fields[2]);
+			break;
+
+		case FREED:
+			fprintf(pFile, "At time %d freed %d bytes from process %d from %d to %d\n", p_event->time, fields[0], p_event->id, fields[1], fields[2]);
+			break;
+
+		case SWAPPED_OUT:
+			fprintf(pFile, "At time %d swapped out %d bytes of process %d from %d to %d\n", p_event->time, fields[0], p_event->id, fields[1], fields[2]);
+			break;
+
+		case SWAPPED_IN:
+			fprintf(pFile, "At time %d swapped in %d bytes of process %d from %d to %d\n", p_event->time, fields[0], p_event->id, fields[1], fields[2]);
+			break;
+
+		case MOVED:
+			fprintf(pFile, "At time %d moved %d bytes of process %d from %d to %d\n", p_event->time, fields[0], p_event->id, fields[1], fields[2]);
+			break;
+
+		case BLOCK_ALLOCATED:
+			fprintf(pFile, "At time %d allocated %d bytes for process %d block %d from %d to %d\n", p_event->time, fields[0], p_event->id, fields[3], fields[1], fields[2]);
+			break;
+
+		case BLOCK_FREED:
+			fprintf(pFile, "At time %d freed %d bytes from process %d block %d from %d to %d\n", p_event->time, fields[0], p_event->id, fields[3], fields[1], fields[2]);
+			break;
+	}
+}
+
+int main(int argc, char * argv[])
+{
+	// open event log (events.bin by default)
+	char *path = (argc > 1) ? argv[1] : instancePath(EVENT_LOG);
+	FILE *pEventFile = fopen(path, "rb");
+	if (pEventFile == NULL)
+	{
+		printf("Could not open file %s\n", path);
+		return -1;
+	}
+
+	FILE *pFile = fopen(instancePath(LOG), "w");
+	fprintf(pFile, "# At time x process y state arr w total z remain y wait k\n");
+	FILE *pMemFile = fopen(instancePath(MEMORY), "w");
+	fprintf(pMemFile, "# At time x allocated y bytes for process z from i to j\n");
+
+	struct logEvent *events = (struct logEvent *) malloc(DECODE_BATCH * sizeof(struct logEvent));
+	long decoded = 0;
+	size_t count;
+	while ((count = fread(events, sizeof(struct logEvent), DECODE_BATCH, pEventFile)) > 0)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			if (events[i].type >= MEMORY_EVENT)
+			{
+				decodeMemoryEvent(pMemFile, &events[i]);
+			}
+			else
+			{
+				decodeSchedulerEvent(pFile, &events[i]);
+			}
+		}
+		decoded += count;
+	}
+	printf("Decoded %ld events into %s and %s\n", decoded, LOG, MEMORY);
+
+	free(events);
+	fclose(pEventFile);
+	fclose(pFile);
+	fclose(pMemFile);
+	return 0;
+}
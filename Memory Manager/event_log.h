@@ -0,0 +1,156 @@
+// Binary event log. Instead of formatting scheduler.log and memory.log on the scheduler's critical
+// path, fixed-size event records are put in a single-producer single-consumer ring in memory, and
+// a background writer thread writes them to EVENT_LOG in large sequential writes. The text logs are
+// regenerated offline by event_decoder.out.
+#include <pthread.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <errno.h>
+
+// output files
+#define EVENT_LOG "events.bin"
+
+// ring capacity in events (a power of two), events per write and writer sleep time in microseconds
+// when fewer events are waiting (can be overridden with -D)
+#ifndef EVENT_RING_SIZE
+#define EVENT_RING_SIZE (1 << 16)
+#endif
+#ifndef EVENT_BATCH
+#define EVENT_BATCH 4096
+#endif
+#ifndef EVENT_FLUSH_INTERVAL
+#define EVENT_FLUSH_INTERVAL 10000
+#endif
+
+// event types: the scheduler log states, then MEMORY_EVENT plus the memory log states
+#define MEMORY_EVENT 8
+#define MOVED 4
+#define BLOCK_ALLOCATED 5
+#define BLOCK_FREED 6
+
+// scheduler events: arrival time, execution time, remaining time and waiting time
+// memory events: memory size, start, end (new start for MOVED) and block handle
+struct logEvent
+{
+	int type;
+	int time;
+	int id;
+	int fields[5];
+};
+
+struct eventLog
+{
+	struct logEvent *ring;
+	unsigned long head;	// next event to put (written by the scheduler)
+	unsigned long tail;	// next event to write (written by the writer thread)
+	bool finished;
+	int fd;
+	pthread_t writer;
+
+	// statistics
+	long events;
+	long writes;
+	long stalls;
+};
+
+struct eventLog eventLog;
+
+void *writeEvents(void *p_arg)
+{
+	(void) p_arg;
+	while (true)
+	{
+		unsigned long head = __atomic_load_n(&eventLog.head, __ATOMIC_ACQUIRE);
+		bool finished = __atomic_load_n(&eventLog.finished, __ATOMIC_ACQUIRE);
+		unsigned long available = head - eventLog.tail;
+		if ((available < EVENT_BATCH) && !finished)
+		{
+			usleep(EVENT_FLUSH_INTERVAL);
+			continue;
+		}
+		if ((available == 0) && finished)
+		{
+			return NULL;
+		}
+
+		// write up to the end of the ring, the rest is written in the next iteration. A short write
+		// is continued, and the tail only passes the records that were written completely.
+		unsigned long tail = eventLog.tail;
+		unsigned long start = tail & (EVENT_RING_SIZE - 1);
+		unsigned long count = (available < EVENT_RING_SIZE - start) ? available : EVENT_RING_SIZE - start;
+		char *p_bytes = (char *) (eventLog.ring + start);
+		size_t size = count * sizeof(struct logEvent);
+		size_t written = 0;
+		while (written < size)
+		{
+			ssize_t result = write(eventLog.fd, p_bytes + written, size - written);
+			eventLog.writes++;
+			if (result == -1)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				
+				// drop the events that cannot be written so that the scheduler does not stall
+				perror("Error in writing event log");
+				written = size;
+			}
+			else
+			{
+				written += result;
+			}
+			__atomic_store_n(&eventLog.tail, tail + (written / sizeof(struct logEvent)), __ATOMIC_RELEASE);
+		}
+	}
+}
+
+void initEventLog()
+{
+	eventLog.ring = (struct logEvent *) malloc(EVENT_RING_SIZE * sizeof(struct logEvent));
+	eventLog.fd = open(instancePath(EVENT_LOG), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (eventLog.fd == -1)
+	{
+		perror("Error in creating event log");
+		exit(-1);
+	}
+	pthread_create(&eventLog.writer, NULL, writeEvents, NULL);
+}
+
+void logEvent(int type, int time, int id, int field0, int field1, int field2, int field3, int field4)
+{
+	// wait for the writer thread if the ring is full
+	if (eventLog.head - __atomic_load_n(&eventLog.tail, __ATOMIC_ACQUIRE) == EVENT_RING_SIZE)
+	{
+		eventLog.stalls++;
+		while (eventLog.head - __atomic_load_n(&eventLog.tail, __ATOMIC_ACQUIRE) == EVENT_RING_SIZE)
+		{
+			sched_yield();
+		}
+	}
+	struct logEvent *p_event = eventLog.ring + (eventLog.head & (EVENT_RING_SIZE - 1));
+	p_event->type = type;
+	p_event->time = time;
+	p_event->id = id;
+	p_event->fields[0] = field0;
+	p_event->fields[1] = field1;
+	p_event->fields[2] = field2;
+	p_event->fields[3] = field3;
+	p_event->fields[4] = field4;
+	eventLog.events++;
+	__atomic_store_n(&eventLog.head, eventLog.head + 1, __ATOMIC_RELEASE);
+}
+
+// writes the remaining events and stops the writer thread
+void closeEventLog()
+{
+	__atomic_store_n(&eventLog.finished, true, __ATOMIC_RELEASE);
+	pthread_join(eventLog.writer, NULL);
+	close(eventLog.fd);
+	free(eventLog.ring);
+}
+
+void writeEventLogPerformance(FILE *pFile)
+{
+	fprintf(pFile, "Event log: %ld events, %ld writes, %ld ring full stalls\n", eventLog.events, eventLog.writes, eventLog.stalls);
+}
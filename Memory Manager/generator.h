@@ -0,0 +1,202 @@
+// Generator side of a simulation: reading the workload and sending the processes that arrive at
+// each time step to the scheduler through the ready queue. Shared by the process generator and
+// the in-process engine.
+#include "workload.h"
+
+// records read at a time from a binary workload, and columns read from a line of a text workload
+#define WORKLOAD_BATCH 4096
+#define WORKLOAD_COLUMNS 16
+
+// reads a text or binary workload and returns its processes in arrival order, or NULL if the
+// file cannot be read
+struct process *readWorkload(char *path, int *p_N)
+{
+	// open file
+	FILE *pFile = fopen(path, "r");    
+	if (pFile == NULL)
+	{
+		printf("Could not open file %s\n", path);
+		return NULL;
+	}
+
+	int N = 0;
+	struct process *processArray;
+	struct workloadHeader header;
+	if ((fread(&header, sizeof(header), 1, pFile) == 1) && (memcmp(header.magic, WORKLOAD_MAGIC, sizeof(header.magic)) == 0))
+	{
+		// binary workload: read the records in batches
+		N = header.count;
+		processArray = (struct process *) malloc(N * sizeof(struct process));
+		struct workloadRecord *records = (struct workloadRecord *) malloc(WORKLOAD_BATCH * sizeof(struct workloadRecord));
+		for (int i = 0; i < N; i += WORKLOAD_BATCH)
+		{
+			int count = ((N - i) < WORKLOAD_BATCH) ? (N - i) : WORKLOAD_BATCH;
+			if ((int) fread(records, sizeof(struct workloadRecord), count, pFile) != count)
+			{
+				printf("File %s is truncated\n", path);
+				free(records);
+				free(processArray);
+				fclose(pFile);
+				return NULL;
+			}
+			for (int j = 0; j < count; j++)
+			{
+				processArray[i + j].id = records[j].id;
+				processArray[i + j].arrivalTime = records[j].arrivalTime;
+				processArray[i + j].runningTime = records[j].runningTime;
+				processArray[i + j].priority = records[j].priority;
+				processArray[i + j].memSize = records[j].memSize;
+				#ifdef DYNAMIC_ALLOCATION
+					processArray[i + j].requestRate = DEFAULT_REQUEST_RATE;
+					processArray[i + j].requestSize = DEFAULT_REQUEST_SIZE;
+				#endif
+			}
+		}
+		free(records);
+		fclose(pFile);
+	}
+	else
+	{
+		// count number of processes in simulation
+		N = -1;
+		rewind(pFile);
+		char c;
+		for (c = getc(pFile); c != EOF; c = getc(pFile))
+		{
+			if (c == '\n')
+			{
+				N += 1;
+			}
+		}
+		fclose(pFile);
+
+		// read input file and create an array of processes
+		pFile = fopen(path, "r");
+		processArray = (struct process *) malloc(N * sizeof(struct process));
+		#ifdef DYNAMIC_ALLOCATION
+			// the optional request rate and mean request size columns are the ones the header names
+			// requestRate and requestSize, or else the first two columns it does not name, so named
+			// columns such as deadlines are skipped
+			char line[256];
+			fgets(line, sizeof(line), pFile);
+			int columns = 0;
+			int rateColumn = -1;
+			int sizeColumn = -1;
+			for (char *name = strtok((line[0] == '#') ? line + 1 : line, " \t\r\n"); name != NULL; name = strtok(NULL, " \t\r\n"))
+			{
+				if (strcmp(name, "requestRate") == 0)
+				{
+					rateColumn = columns;
+				}
+				else if (strcmp(name, "requestSize") == 0)
+				{
+					sizeColumn = columns;
+				}
+				columns++;
+			}
+			rateColumn = (rateColumn == -1) ? columns++ : rateColumn;
+			sizeColumn = (sizeColumn == -1) ? columns++ : sizeColumn;
+		#else
+			fscanf(pFile, "%*[^\n]\n");
+		#endif
+		for (int i = 0; i < N; i++)
+		{
+			#ifdef DYNAMIC_ALLOCATION
+				int values[WORKLOAD_COLUMNS];
+				int count = 0;
+				fgets(line, sizeof(line), pFile);
+				for (char *field = strtok(line, " \t\r\n"); (field != NULL) && (count < WORKLOAD_COLUMNS); field = strtok(NULL, " \t\r\n"))
+				{
+					values[count++] = atoi(field);
+				}
+				processArray[i].id = values[0];
+				processArray[i].arrivalTime = values[1];
+				processArray[i].runningTime = values[2];
+				processArray[i].priority = values[3];
+				processArray[i].memSize = values[4];
+				processArray[i].requestRate = (rateColumn < count) ? values[rateColumn] : DEFAULT_REQUEST_RATE;
+				processArray[i].requestSize = (sizeColumn < count) ? values[sizeColumn] : DEFAULT_REQUEST_SIZE;
+			#else
+				// columns after memSize (such as deadlines) are skipped
+				fscanf(pFile, "%d\t%d\t%d\t%d\t%d%*[^\n]\n", &processArray[i].id, &processArray[i].arrivalTime, &processArray[i].runningTime, &processArray[i].priority, &processArray[i].memSize);
+			#endif
+		}
+		fclose(pFile);
+	}
+	for (int i = 0; i < N; i++)
+	{
+		processArray[i].remainingTime = processArray[i].runningTime;
+		processArray[i].allocationSize = allocationSizeFor(processArray[i].memSize);
+		processArray[i].allocatedMemUnit = NULL;
+		processArray[i].next = -1;
+		processArray[i].prev = -1;
+	}
+	*p_N = N;
+	return processArray;
+}
+
+int schedulerFromName(char *name)
+{
+	char *schedulerNames[] = {"hpf", "srtn", "rr"};
+	for (int i = HPF; i <= RR; i++)
+	{
+		if (strcmp(name, schedulerNames[i]) == 0)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+// initializes the memory shared between the generator and the scheduler
+void initSchedulerInfo(struct schedulerInfo *p_schedulerInfo, int N)
+{
+	struct readyQueue *p_readyQueue = (struct readyQueue *) (p_schedulerInfo + 1);
+	p_schedulerInfo->generationFinished = false;
+	p_schedulerInfo->quantum = 0;
+	p_schedulerInfo->allocatorType = allocatorType;
+	#ifdef HOT_PATH_STATS
+		memset(&p_schedulerInfo->generatorHotPath, 0, sizeof(struct hotPathStats));
+	#endif
+	p_readyQueue->head = -1;
+	p_readyQueue->tail = -1;
+	p_readyQueue->processArrival = false;
+	p_readyQueue->size = N;
+	p_readyQueue->count = 0;
+	p_readyQueue->sequence = 0;
+	p_readyQueue->schedulerType = -1;
+}
+
+// sends the processes that arrive at currentTime to the scheduler, processIndex is the next
+// process to arrive
+void generateArrivals(struct schedulerInfo *p_schedulerInfo, struct process *processArray, int N, int *processIndex, int currentTime)
+{
+	if (p_schedulerInfo->generationFinished)
+	{
+		return;
+	}
+	struct readyQueue *p_readyQueue = (struct readyQueue *) (p_schedulerInfo + 1);
+	struct process *p_processBufferStart = sharedProcessBuffer(p_schedulerInfo);
+	struct process *p_process = p_processBufferStart + (*processIndex);
+	while (processArray[*processIndex].arrivalTime == currentTime)
+	{			 
+		*p_process = processArray[*processIndex]; // physical allocation
+		enqueue(p_readyQueue, p_processBufferStart, p_process, *processIndex, p_schedulerInfo->schedulerType);
+		p_readyQueue->processArrival = true;
+		#ifdef PRINTING
+			printf("Process Generator: Process %d arrived\n", p_process->id);
+		#endif	
+		
+		if (((*processIndex) + 1) == N)
+		{
+			p_schedulerInfo->generationFinished = true;
+			break;
+		}
+		p_process += 1;
+		(*processIndex)++;
+	}
+	#if defined(HOT_PATH_STATS) && !defined(IN_PROCESS)
+		// publish the enqueues of the arrivals for the scheduler to merge into its table
+		p_schedulerInfo->generatorHotPath = hotPath;
+	#endif
+}
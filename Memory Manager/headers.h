@@ -11,9 +11,13 @@
 #include <unistd.h>
 #include <signal.h>
 #include <math.h>
+#include <string.h>
+#include "hot_path_stats.h"
 
 //flags
+#if !defined(BINARY_LOG) && !defined(IN_PROCESS)
 #define PRINTING
+#endif
 
 typedef short bool;
 #define true 1
@@ -21,6 +25,46 @@ typedef short bool;
 
 #define SHKEY 300
 
+// Simulations with different OSSIM_INSTANCE environment variables (inherited by the clock, the
+// scheduler and the processes) use different IPC keys and output files, so they can run at the
+// same time. Instance 0, the default, uses the original keys and file names.
+#define INSTANCE_VARIABLE "OSSIM_INSTANCE"
+#define INSTANCE_KEY_BASE 0x4F530000	// above the largest pid, so instance keys never match PCB keys
+#define INSTANCE_KEYS 16
+
+int instance = -1;
+char instancePathBuffer[256];
+
+int simulationInstance()
+{
+	if (instance == -1)
+	{
+		char *value = getenv(INSTANCE_VARIABLE);
+		instance = (value != NULL) ? atoi(value) : 0;
+	}
+	return instance;
+}
+
+// keys are multiples of 100 below INSTANCE_KEYS * 100
+key_t ipcKey(int key)
+{
+	return (simulationInstance() == 0) ? key : INSTANCE_KEY_BASE + simulationInstance() * INSTANCE_KEYS + key / 100;
+}
+
+// inserts the instance before the extension (scheduler.log becomes scheduler.3.log), the result
+// is valid until the next call
+char *instancePath(char *name)
+{
+	if (simulationInstance() == 0)
+	{
+		return name;
+	}
+	char *extension = strrchr(name, '.');
+	int length = (extension != NULL) ? (int) (extension - name) : (int) strlen(name);
+	snprintf(instancePathBuffer, sizeof(instancePathBuffer), "%.*s.%d%s", length, name, simulationInstance(), (extension != NULL) ? extension : "");
+	return instancePathBuffer;
+}
+
 ///==============================
 //don't mess with this variable//
 int * shmaddr;                 //
@@ -40,13 +84,13 @@ int getClk()
 */
 void initClk()
 {
-    int shmid = shmget(SHKEY, 4, 0444);
+    int shmid = shmget(ipcKey(SHKEY), 4, 0444);
     while ((int)shmid == -1)
     {
         //Make sure that the clock exists
         printf("Wait! The clock not initialized yet!\n");
         sleep(1);
-        shmid = shmget(SHKEY, 4, 0444);
+        shmid = shmget(ipcKey(SHKEY), 4, 0444);
     }
     shmaddr = (int *) shmat(shmid, (void *)0, 0);
 }
@@ -0,0 +1,98 @@
+// Hot path statistics. With HOT_PATH_STATS each instrumented operation counts its calls, the
+// time spent in it (in cycles from rdtsc on x86, in nanoseconds from CLOCK_MONOTONIC_RAW
+// otherwise or with HOT_PATH_CLOCK_GETTIME) and the work it did: ready queue keys compared,
+// memory units visited, units split, units merged and waiting list classes scanned. The timer of
+// an operation stops when the function returns, so the times include nested operations. Without
+// HOT_PATH_STATS the macros are empty.
+
+// operations
+#define ENQUEUE_OPERATION 0
+#define DEQUEUE_OPERATION 1
+#define ALLOCATE_OPERATION 2
+#define SPLIT_ALLOCATE_OPERATION 3
+#define DEALLOCATE_OPERATION 4
+#define WAITING_LIST_SCAN_OPERATION 5
+#define PROCESS_CREATION_OPERATION 6
+#define LOG_WRITE_OPERATION 7
+#define HOT_PATH_OPERATIONS 8
+
+#ifdef HOT_PATH_STATS
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(HOT_PATH_CLOCK_GETTIME)
+#include <x86intrin.h>
+#define HOT_PATH_UNIT "cycles"
+
+unsigned long long readHotPathClock()
+{
+	return __rdtsc();
+}
+#else
+#include <time.h>
+#define HOT_PATH_UNIT "ns"
+
+unsigned long long readHotPathClock()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+	return now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+#endif
+
+struct hotPathStats
+{
+	unsigned long long start;
+	long calls[HOT_PATH_OPERATIONS];
+	unsigned long long time[HOT_PATH_OPERATIONS];
+	long work[HOT_PATH_OPERATIONS];
+};
+
+struct hotPathStats hotPath;
+
+struct hotPathTimer
+{
+	int operation;
+	unsigned long long start;
+};
+
+void stopHotPathTimer(struct hotPathTimer *p_timer)
+{
+	hotPath.calls[p_timer->operation]++;
+	hotPath.time[p_timer->operation] += readHotPathClock() - p_timer->start;
+}
+
+// starts a timer that is stopped when the enclosing scope is left
+#define HOT_PATH_TIMER(operation) struct hotPathTimer hotPathTimer __attribute__((cleanup(stopHotPathTimer))) = {operation, readHotPathClock()}
+#define HOT_PATH_WORK(operation, amount) (hotPath.work[operation] += (amount))
+
+void initHotPathStats()
+{
+	hotPath.start = readHotPathClock();
+}
+
+// adds the calls, times and work of another process (the process generator) to the table
+void mergeHotPathStats(struct hotPathStats *p_stats)
+{
+	for (int i = 0; i < HOT_PATH_OPERATIONS; i++)
+	{
+		hotPath.calls[i] += p_stats->calls[i];
+		hotPath.time[i] += p_stats->time[i];
+		hotPath.work[i] += p_stats->work[i];
+	}
+}
+
+void writeHotPathPerformance(FILE *pFile)
+{
+	char *names[] = {"enqueue", "dequeue", "allocate", "splitAllocate", "deallocate", "waiting list scan", "process creation", "log write"};
+	char *work[] = {" keys compared", "", " units visited", " units split", " units merged", " classes scanned", "", ""};
+	unsigned long long elapsed = readHotPathClock() - hotPath.start;
+	fprintf(pFile, "Hot path (%s, inclusive of nested operations):\n", HOT_PATH_UNIT);
+	fprintf(pFile, "%-18s %10s %14s %10s %7s %10s %9s\n", "operation", "calls", "total", "per call", "share", "work", "per call");
+	for (int i = 0; i < HOT_PATH_OPERATIONS; i++)
+	{
+		long calls = hotPath.calls[i];
+		fprintf(pFile, "%-18s %10ld %14llu %10.1f %6.3f%% %10ld %9.2f%s\n", names[i], calls, hotPath.time[i], (calls == 0) ? 0 : hotPath.time[i] / (double) calls, (elapsed == 0) ? 0 : 100.0 * hotPath.time[i] / elapsed, hotPath.work[i], (calls == 0) ? 0 : hotPath.work[i] / (double) calls, work[i]);
+	}
+}
+#else
+#define HOT_PATH_TIMER(operation)
+#define HOT_PATH_WORK(operation, amount)
+#endif
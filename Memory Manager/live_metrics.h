@@ -0,0 +1,100 @@
+// Live metrics. The scheduler publishes its state once per time step in a named shared memory
+// segment protected by a sequence lock: the sequence is odd while the block is being written, and
+// a reader retries if the sequence was odd or changed while it copied the block. Readers map the
+// segment read-only and never make the scheduler wait.
+#include <sys/mman.h>
+#include <fcntl.h>
+
+// name of the shared memory segment
+#define METRICS_SHM_NAME "/ossim-metrics"
+
+struct liveMetrics
+{
+	unsigned int sequence;
+	int schedulerPid;
+	bool simulationFinished;
+	int tick;
+	int runningProcess;	// id of the running process, 0 if none
+	int readyProcesses;
+	int waitingProcesses;
+	int finishedProcesses;
+	int processes;
+	float utilization;
+	int freeMemory;
+	int largestFree;
+};
+
+struct liveMetrics *p_liveMetrics;
+
+void initLiveMetrics(int N)
+{
+	int fd = shm_open(instancePath(METRICS_SHM_NAME), O_CREAT | O_RDWR, 0644);
+	if ((fd == -1) || (ftruncate(fd, sizeof(struct liveMetrics)) == -1))
+	{
+		perror("Error in creating live metrics");
+		exit(-1);
+	}
+	p_liveMetrics = (struct liveMetrics *) mmap(NULL, sizeof(struct liveMetrics), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	p_liveMetrics->sequence = 0;
+	p_liveMetrics->schedulerPid = getpid();
+	p_liveMetrics->simulationFinished = false;
+	p_liveMetrics->processes = N;
+}
+
+void beginMetricsUpdate()
+{
+	__atomic_store_n(&p_liveMetrics->sequence, p_liveMetrics->sequence + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void endMetricsUpdate()
+{
+	__atomic_store_n(&p_liveMetrics->sequence, p_liveMetrics->sequence + 1, __ATOMIC_RELEASE);
+}
+
+void publishMetrics(int currentTime, struct process *p_runningProcess, int readyProcesses, int waitingProcesses, int finishedProcesses, int wastedTime, struct memUnit *memory)
+{
+	beginMetricsUpdate();
+	p_liveMetrics->tick = currentTime;
+	p_liveMetrics->runningProcess = (p_runningProcess != NULL) ? p_runningProcess->id : 0;
+	p_liveMetrics->readyProcesses = readyProcesses;
+	p_liveMetrics->waitingProcesses = waitingProcesses;
+	p_liveMetrics->finishedProcesses = finishedProcesses;
+	p_liveMetrics->utilization = (currentTime == 0) ? 0 : (currentTime - wastedTime) / (float) currentTime;
+	p_liveMetrics->freeMemory = MEMORY_SIZE - memoryCounters.allocatedBytes;
+	p_liveMetrics->largestFree = largestFreeSize(memory);
+	endMetricsUpdate();
+}
+
+void finishLiveMetrics()
+{
+	beginMetricsUpdate();
+	p_liveMetrics->simulationFinished = true;
+	endMetricsUpdate();
+}
+
+void destroyLiveMetrics()
+{
+	munmap(p_liveMetrics, sizeof(struct liveMetrics));
+	shm_unlink(instancePath(METRICS_SHM_NAME));
+}
+
+// copies a consistent snapshot of the metrics, retrying while the scheduler is writing them
+void readMetrics(struct liveMetrics *p_metrics, struct liveMetrics *p_snapshot)
+{
+	while (true)
+	{
+		unsigned int sequence = __atomic_load_n(&p_metrics->sequence, __ATOMIC_ACQUIRE);
+		if (sequence % 2 == 1)
+		{
+			continue;
+		}
+		*p_snapshot = *p_metrics;
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&p_metrics->sequence, __ATOMIC_RELAXED) == sequence)
+		{
+			return;
+		}
+	}
+}
@@ -0,0 +1,82 @@
+// Fragmentation statistics. The allocator counters, the largest free memory unit and the
+// waiting list depth are sampled periodically and written to a CSV time series, and their
+// averages and extremes are written to the performance log.
+
+// output files
+#define MEMORY_STATS_LOG "memory.csv"
+
+// sampling period in time steps (can be overridden with -D)
+#ifndef MEMORY_SAMPLE_INTERVAL
+#define MEMORY_SAMPLE_INTERVAL 1
+#endif
+
+struct memoryStats
+{
+	FILE *pFile;
+	int samples;
+	long internalSum;
+	int internalMax;
+	double externalSum;
+	double externalMax;
+	int largestFreeMin;
+	long waitingSum;
+	int waitingMax;
+	long utilizationSum;
+};
+
+struct memoryStats memoryStats;
+
+void initMemoryStats()
+{
+	memoryStats.pFile = fopen(instancePath(MEMORY_STATS_LOG), "w");
+	fprintf(memoryStats.pFile, "time,allocated,requested,internal,free,largest_free,external,waiting\n");
+	memoryStats.largestFreeMin = MEMORY_SIZE;
+}
+
+void sampleMemory(int currentTime, struct memUnit *memory, struct waitingQueue *waitingList)
+{
+	if (currentTime % MEMORY_SAMPLE_INTERVAL != 0)
+	{
+		return;
+	}
+
+	// internal fragmentation is the unused part of the allocated units and external
+	// fragmentation is the fraction of free memory outside the largest free unit
+	int internal = memoryCounters.allocatedBytes - memoryCounters.requestedBytes;
+	int free = MEMORY_SIZE - memoryCounters.allocatedBytes;
+	int largestFree = largestFreeSize(memory);
+	double external = (free == 0) ? 0 : 1 - (largestFree / (double) free);
+	fprintf(memoryStats.pFile, "%d,%d,%d,%d,%d,%d,%.4f,%d\n", currentTime, memoryCounters.allocatedBytes, memoryCounters.requestedBytes, internal, free, largestFree, external, waitingList->count);
+
+	memoryStats.samples++;
+	memoryStats.internalSum += internal;
+	memoryStats.externalSum += external;
+	memoryStats.waitingSum += waitingList->count;
+	memoryStats.utilizationSum += memoryCounters.allocatedBytes;
+	if (internal > memoryStats.internalMax)
+	{
+		memoryStats.internalMax = internal;
+	}
+	if (external > memoryStats.externalMax)
+	{
+		memoryStats.externalMax = external;
+	}
+	if (largestFree < memoryStats.largestFreeMin)
+	{
+		memoryStats.largestFreeMin = largestFree;
+	}
+	if (waitingList->count > memoryStats.waitingMax)
+	{
+		memoryStats.waitingMax = waitingList->count;
+	}
+}
+
+void writeMemoryStatsPerformance(FILE *pFile)
+{
+	int samples = (memoryStats.samples == 0) ? 1 : memoryStats.samples;
+	fprintf(pFile, "Memory utilization = %.2f%%\n", (memoryStats.utilizationSum / (float) samples) / MEMORY_SIZE * 100);
+	fprintf(pFile, "Avg internal fragmentation = %.2f bytes (max %d)\n", memoryStats.internalSum / (float) samples, memoryStats.internalMax);
+	fprintf(pFile, "Avg external fragmentation = %.2f%% (max %.2f%%)\n", memoryStats.externalSum / samples * 100, memoryStats.externalMax * 100);
+	fprintf(pFile, "Min largest free unit = %d bytes\n", memoryStats.largestFreeMin);
+	fprintf(pFile, "Avg waiting list depth = %.2f (max %d)\n", memoryStats.waitingSum / (float) samples, memoryStats.waitingMax);
+}
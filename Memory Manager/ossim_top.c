@@ -0,0 +1,65 @@
+#include "headers.h"
+#include "scheduler_utilities.h"
+#include "live_metrics.h"
+
+// default sampling interval in milliseconds
+#define SAMPLE_INTERVAL 500
+
+void printMetrics(struct liveMetrics *p_metrics)
+{
+	printf("\033[H\033[2J"); // clear screen
+	printf("ossim-top - scheduler %d%s\n\n", p_metrics->schedulerPid, p_metrics->simulationFinished ? " (finished)" : "");
+	printf("Time:              %d\n", p_metrics->tick);
+	if (p_metrics->runningProcess != 0)
+	{
+		printf("Running process:   %d\n", p_metrics->runningProcess);
+	}
+	else
+	{
+		printf("Running process:   none\n");
+	}
+	printf("Ready processes:   %d\n", p_metrics->readyProcesses);
+	printf("Waiting processes: %d\n", p_metrics->waitingProcesses);
+	printf("Finished:          %d / %d\n", p_metrics->finishedProcesses, p_metrics->processes);
+	printf("CPU utilization:   %.2f%%\n", p_metrics->utilization * 100);
+	printf("Free memory:       %d / %d bytes\n", p_metrics->freeMemory, MEMORY_SIZE);
+	printf("Largest free unit: %d bytes\n", p_metrics->largestFree);
+	fflush(stdout);
+}
+
+int main(int argc, char * argv[])
+{
+	int interval = (argc > 1) ? atoi(argv[1]) : SAMPLE_INTERVAL;
+
+	// wait for the scheduler to create the metrics block
+	int fd;
+	while ((fd = shm_open(instancePath(METRICS_SHM_NAME), O_RDONLY, 0)) == -1)
+	{
+		printf("\rWaiting for the scheduler...");
+		fflush(stdout);
+		usleep(interval * 1000);
+	}
+	struct liveMetrics *p_metrics = (struct liveMetrics *) mmap(NULL, sizeof(struct liveMetrics), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p_metrics == MAP_FAILED)
+	{
+		perror("Error in mapping live metrics");
+		return -1;
+	}
+
+	// sample until the simulation finishes or the scheduler exits
+	struct liveMetrics snapshot;
+	do
+	{
+		readMetrics(p_metrics, &snapshot);
+		printMetrics(&snapshot);
+		if (snapshot.simulationFinished || (kill(snapshot.schedulerPid, 0) == -1))
+		{
+			break;
+		}
+		usleep(interval * 1000);
+	} while (true);
+
+	munmap(p_metrics, sizeof(struct liveMetrics));
+	return 0;
+}
@@ -0,0 +1,700 @@
+// Paged virtual memory simulation. Each process has a virtual address space of memSize
+// bytes that is translated through a software TLB and a two-level page table (allocated
+// lazily) into fixed-size frames. Pages are loaded on demand while the process runs,
+// driven by a synthetic access pattern chosen per process.
+
+// output files
+#define PAGING_LOG "paging.log"
+
+// paging parameters (can be overridden with -D)
+#ifndef PAGE_SIZE
+#define PAGE_SIZE 16
+#endif
+#ifndef PAGE_TABLE_ENTRIES
+#define PAGE_TABLE_ENTRIES 8
+#endif
+#ifndef TLB_ENTRIES
+#define TLB_ENTRIES 16
+#endif
+#ifndef TLB_WAYS
+#define TLB_WAYS 4
+#endif
+#ifndef ACCESSES_PER_TICK
+#define ACCESSES_PER_TICK 32
+#endif
+
+// latencies in cycles
+#ifndef TLB_HIT_LATENCY
+#define TLB_HIT_LATENCY 1
+#endif
+#ifndef PAGE_WALK_LATENCY
+#define PAGE_WALK_LATENCY 20
+#endif
+#ifndef PAGE_FAULT_LATENCY
+#define PAGE_FAULT_LATENCY 5000
+#endif
+
+// number of physical frames, lower it to oversubscribe memory and study page replacement
+#ifndef FRAMES
+#define FRAMES (MEMORY_SIZE / PAGE_SIZE)
+#endif
+#define VIRTUAL_PAGES (MEMORY_SIZE / PAGE_SIZE)
+#define PAGE_DIRECTORY_ENTRIES ((VIRTUAL_PAGES + PAGE_TABLE_ENTRIES - 1) / PAGE_TABLE_ENTRIES)
+#define TLB_SETS (TLB_ENTRIES / TLB_WAYS)
+
+// access patterns
+#define SEQUENTIAL 0
+#define RANDOM 1
+#define LOCALITY 2
+
+// paging log states
+#define PAGE_FAULT 0
+#define EVICTED 1
+
+// page replacement policies
+#define FIFO 0
+#define LRU 1
+#define CLOCK 2
+#define ARC 3
+#define POLICIES 4
+
+// policy that drives paging.log, the other policies are simulated on the same accesses
+#ifndef REPLACEMENT_POLICY
+#define REPLACEMENT_POLICY LRU
+#endif
+
+// replacement lists (FIFO, LRU and CLOCK only use T1)
+#define T1 0
+#define T2 1
+#define B1 2
+#define B2 3
+#define NO_LIST -1
+
+// frames of the running process taken off the head of T1 and T2 while selecting victims,
+// they are put back when another process runs
+#define SKIPPED_T1 4
+#define SKIPPED_T2 5
+#define LISTS 6
+
+struct pageTableEntry
+{
+	int frame;
+	bool present;
+	int ghost;	// ARC ghost node of an evicted page, -1 if none
+};
+
+struct pageDirectory
+{
+	struct pageTableEntry *tables[PAGE_DIRECTORY_ENTRIES];
+};
+
+struct tlbEntry
+{
+	bool valid;
+	int processIndex;
+	int page;
+	int frame;
+	long lastUsed;
+};
+
+struct frame
+{
+	int processIndex;	// -1 if the frame is free
+	int page;
+	bool referenced;
+};
+
+// Doubly linked lists over nodes: nodes 0 to FRAMES - 1 are the frames and nodes
+// FRAMES to 2 * FRAMES - 1 are the ghost entries of ARC.
+struct nodeList
+{
+	int head;	// least recently used
+	int tail;	// most recently used
+	int size;
+};
+
+struct pagingProcess
+{
+	struct pageDirectory *p_directory;
+	unsigned int seed;
+	int lastAddress;
+	long accesses;
+	long pageFaults;
+	long latency;
+};
+
+struct pagingState
+{
+	int policy;
+	FILE *pFile;	// NULL for the policies that do not write paging.log
+	struct pagingProcess *processes;
+	struct frame frames[FRAMES];
+	int freeFrames[FRAMES];
+	int freeFramesCount;
+	struct tlbEntry tlb[TLB_SETS][TLB_WAYS];
+	
+	// replacement state
+	struct nodeList lists[LISTS];
+	int nodeNext[2 * FRAMES];
+	int nodePrev[2 * FRAMES];
+	int nodeList[2 * FRAMES];
+	int ghostProcess[FRAMES];
+	int ghostPage[FRAMES];
+	int freeGhosts[FRAMES];
+	int freeGhostsCount;
+	int runningIndex;	// process whose frames are in the skipped lists, -1 if none
+	int arcTarget;
+	
+	// statistics
+	long time;
+	long accesses;
+	long tlbHits;
+	long pageFaults;
+	long evictions;
+};
+
+struct pagingState paging[POLICIES];
+char *policyNames[POLICIES] = {"FIFO", "LRU", "CLOCK", "ARC"};
+
+void initPaging(int N, FILE *pFile)
+{
+	for (int policy = 0; policy < POLICIES; policy++)
+	{
+		struct pagingState *p_paging = &paging[policy];
+		p_paging->policy = policy;
+		p_paging->pFile = (policy == REPLACEMENT_POLICY) ? pFile : NULL;
+		p_paging->processes = (struct pagingProcess *) calloc(N, sizeof(struct pagingProcess));
+		for (int i = 0; i < N; i++)
+		{
+			p_paging->processes[i].seed = i + 1;
+		}
+		for (int i = 0; i < FRAMES; i++)
+		{
+			p_paging->frames[i].processIndex = -1;
+			p_paging->freeFrames[i] = FRAMES - 1 - i;
+			p_paging->freeGhosts[i] = (2 * FRAMES) - 1 - i;
+		}
+		p_paging->freeFramesCount = FRAMES;
+		p_paging->freeGhostsCount = FRAMES;
+		p_paging->runningIndex = -1;
+		for (int i = 0; i < (2 * FRAMES); i++)
+		{
+			p_paging->nodeList[i] = NO_LIST;
+		}
+		for (int i = 0; i < LISTS; i++)
+		{
+			p_paging->lists[i].head = -1;
+			p_paging->lists[i].tail = -1;
+			p_paging->lists[i].size = 0;
+		}
+		for (int i = 0; i < TLB_SETS; i++)
+		{
+			for (int j = 0; j < TLB_WAYS; j++)
+			{
+				p_paging->tlb[i][j].valid = false;
+			}
+		}
+	}
+}
+
+void writePagingLog(struct pagingState *p_paging, int currentTime, struct process *p_processBufferStart, int processIndex, int page, int frame, int logType)
+{
+	if (p_paging->pFile == NULL)
+	{
+		return;
+	}
+	
+	switch (logType)
+	{
+		case PAGE_FAULT:
+			fprintf(p_paging->pFile, "At time %d process %d page fault on page %d loaded in frame %d\n", currentTime, p_processBufferStart[processIndex].id, page, frame);
+			break;
+
+		case EVICTED:
+			fprintf(p_paging->pFile, "At time %d evicted page %d of process %d from frame %d\n", currentTime, page, p_processBufferStart[processIndex].id, frame);
+			break;
+	}
+}
+
+struct pageTableEntry *getPageTableEntry(struct pagingProcess *p_pagingProcess, int page)
+{
+	// allocate page directory and page table on first use
+	if (p_pagingProcess->p_directory == NULL)
+	{
+		p_pagingProcess->p_directory = (struct pageDirectory *) calloc(1, sizeof(struct pageDirectory));
+	}
+	struct pageTableEntry **p_table = &p_pagingProcess->p_directory->tables[page / PAGE_TABLE_ENTRIES];
+	if (*p_table == NULL)
+	{
+		*p_table = (struct pageTableEntry *) calloc(PAGE_TABLE_ENTRIES, sizeof(struct pageTableEntry));
+		for (int i = 0; i < PAGE_TABLE_ENTRIES; i++)
+		{
+			(*p_table)[i].ghost = -1;
+		}
+	}
+	return *p_table + (page % PAGE_TABLE_ENTRIES);
+}
+
+void invalidateTLB(struct pagingState *p_paging, int processIndex, int page)
+{
+	struct tlbEntry *set = p_paging->tlb[page % TLB_SETS];
+	for (int i = 0; i < TLB_WAYS; i++)
+	{
+		if (set[i].valid && (set[i].processIndex == processIndex) && (set[i].page == page))
+		{
+			set[i].valid = false;
+		}
+	}
+}
+
+// ==============================
+// replacement lists
+// ==============================
+
+void listRemove(struct pagingState *p_paging, int node)
+{
+	struct nodeList *p_list = &p_paging->lists[p_paging->nodeList[node]];
+	int prev = p_paging->nodePrev[node];
+	int next = p_paging->nodeNext[node];
+	if (prev == -1)
+	{
+		p_list->head = next;
+	}
+	else
+	{
+		p_paging->nodeNext[prev] = next;
+	}
+	if (next == -1)
+	{
+		p_list->tail = prev;
+	}
+	else
+	{
+		p_paging->nodePrev[next] = prev;
+	}
+	p_list->size--;
+	p_paging->nodeList[node] = NO_LIST;
+}
+
+void listAppend(struct pagingState *p_paging, int list, int node)
+{
+	struct nodeList *p_list = &p_paging->lists[list];
+	p_paging->nodePrev[node] = p_list->tail;
+	p_paging->nodeNext[node] = -1;
+	if (p_list->tail == -1)
+	{
+		p_list->head = node;
+	}
+	else
+	{
+		p_paging->nodeNext[p_list->tail] = node;
+	}
+	p_list->tail = node;
+	p_list->size++;
+	p_paging->nodeList[node] = list;
+}
+
+void listPrepend(struct pagingState *p_paging, int list, int node)
+{
+	struct nodeList *p_list = &p_paging->lists[list];
+	p_paging->nodePrev[node] = -1;
+	p_paging->nodeNext[node] = p_list->head;
+	if (p_list->head == -1)
+	{
+		p_list->tail = node;
+	}
+	else
+	{
+		p_paging->nodePrev[p_list->head] = node;
+	}
+	p_list->head = node;
+	p_list->size++;
+	p_paging->nodeList[node] = list;
+}
+
+// number of resident frames of T1 or T2, including the skipped frames of the running process
+int residentSize(struct pagingState *p_paging, int list)
+{
+	return p_paging->lists[list].size + p_paging->lists[SKIPPED_T1 + list].size;
+}
+
+// returns the least recently used frame of T1 or T2 that does not belong to the running process,
+// the least recently used frame if all of them do, or -1 if the list is empty. The frames of the
+// running process at the head are moved to the skipped list once, so each of them is only passed
+// over once while the process runs.
+int listVictim(struct pagingState *p_paging, int list, int runningIndex)
+{
+	int node = p_paging->lists[list].head;
+	while ((node != -1) && (p_paging->frames[node].processIndex == runningIndex))
+	{
+		listRemove(p_paging, node);
+		listAppend(p_paging, SKIPPED_T1 + list, node);
+		node = p_paging->lists[list].head;
+	}
+	return (node != -1) ? node : p_paging->lists[SKIPPED_T1 + list].head;
+}
+
+// puts the skipped frames back at the head of T1 and T2, where they were taken from, when another
+// process runs
+void restoreSkipped(struct pagingState *p_paging, int runningIndex)
+{
+	for (int list = T1; list <= T2; list++)
+	{
+		struct nodeList *p_skipped = &p_paging->lists[SKIPPED_T1 + list];
+		while (p_skipped->head != -1)
+		{
+			int node = p_skipped->tail;
+			listRemove(p_paging, node);
+			listPrepend(p_paging, list, node);
+		}
+	}
+	p_paging->runningIndex = runningIndex;
+}
+
+// ==============================
+// ARC ghost entries
+// ==============================
+
+void addGhost(struct pagingState *p_paging, int list, int processIndex, int page)
+{
+	int node = p_paging->freeGhosts[--p_paging->freeGhostsCount];
+	p_paging->ghostProcess[node - FRAMES] = processIndex;
+	p_paging->ghostPage[node - FRAMES] = page;
+	getPageTableEntry(&p_paging->processes[processIndex], page)->ghost = node;
+	listAppend(p_paging, list, node);
+}
+
+void removeGhost(struct pagingState *p_paging, int node)
+{
+	getPageTableEntry(&p_paging->processes[p_paging->ghostProcess[node - FRAMES]], p_paging->ghostPage[node - FRAMES])->ghost = -1;
+	listRemove(p_paging, node);
+	p_paging->freeGhosts[p_paging->freeGhostsCount++] = node;
+}
+
+// ==============================
+// page replacement
+// ==============================
+
+// evicts the page of a frame, ARC remembers it in a ghost list if remember is set
+void evictFrame(struct pagingState *p_paging, int currentTime, struct process *p_processBufferStart, int frame, bool remember)
+{
+	struct frame *p_frame = &p_paging->frames[frame];
+	getPageTableEntry(&p_paging->processes[p_frame->processIndex], p_frame->page)->present = false;
+	invalidateTLB(p_paging, p_frame->processIndex, p_frame->page);
+	writePagingLog(p_paging, currentTime, p_processBufferStart, p_frame->processIndex, p_frame->page, frame, EVICTED);
+	
+	// ARC remembers the evicted page in the ghost list matching its resident list
+	int list = p_paging->nodeList[frame];
+	if (list != NO_LIST)
+	{
+		listRemove(p_paging, frame);
+	}
+	if (remember && (p_paging->freeGhostsCount > 0))
+	{
+		addGhost(p_paging, ((list == T1) || (list == SKIPPED_T1)) ? B1 : B2, p_frame->processIndex, p_frame->page);
+	}
+	p_frame->processIndex = -1;
+	p_paging->evictions++;
+}
+
+int clockVictim(struct pagingState *p_paging, int runningIndex)
+{
+	// the clock is T1 with the hand at its head: give a second chance to referenced frames by
+	// moving them behind the hand, each reference is cleared once so the sweep is amortized O(1)
+	int frame = listVictim(p_paging, T1, runningIndex);
+	while ((p_paging->nodeList[frame] == T1) && p_paging->frames[frame].referenced)
+	{
+		p_paging->frames[frame].referenced = false;
+		listRemove(p_paging, frame);
+		listAppend(p_paging, T1, frame);
+		frame = listVictim(p_paging, T1, runningIndex);
+	}
+	return frame;
+}
+
+int arcVictim(struct pagingState *p_paging, int runningIndex, bool inB2)
+{
+	// REPLACE(x, p) of ARC
+	int t1Size = residentSize(p_paging, T1);
+	if ((t1Size > 0) && ((t1Size > p_paging->arcTarget) || (inB2 && (t1Size == p_paging->arcTarget))))
+	{
+		return listVictim(p_paging, T1, runningIndex);
+	}
+	if (residentSize(p_paging, T2) > 0)
+	{
+		return listVictim(p_paging, T2, runningIndex);
+	}
+	return listVictim(p_paging, T1, runningIndex);
+}
+
+int getFreeFrame(struct pagingState *p_paging, int currentTime, struct process *p_processBufferStart, int runningIndex, bool inB2)
+{
+	if (p_paging->freeFramesCount > 0)
+	{
+		return p_paging->freeFrames[--p_paging->freeFramesCount];
+	}
+	
+	// no free frame: select a victim
+	int victim = 0;
+	switch (p_paging->policy)
+	{
+		case FIFO:
+		case LRU:
+			victim = listVictim(p_paging, T1, runningIndex);
+			break;
+		
+		case CLOCK:
+			victim = clockVictim(p_paging, runningIndex);
+			break;
+		
+		case ARC:
+			victim = arcVictim(p_paging, runningIndex, inB2);
+			break;
+	}
+	evictFrame(p_paging, currentTime, p_processBufferStart, victim, (p_paging->policy == ARC));
+	return victim;
+}
+
+// updates the replacement state of a resident page on every access
+void touchFrame(struct pagingState *p_paging, int frame)
+{
+	switch (p_paging->policy)
+	{
+		case LRU:
+			listRemove(p_paging, frame);
+			listAppend(p_paging, T1, frame);
+			break;
+		
+		case CLOCK:
+			p_paging->frames[frame].referenced = true;
+			break;
+		
+		case ARC:
+			listRemove(p_paging, frame);
+			listAppend(p_paging, T2, frame);
+			break;
+	}
+}
+
+// loads a page in a frame and returns the frame
+int loadPage(struct pagingState *p_paging, int currentTime, struct process *p_processBufferStart, int processIndex, int page, struct pageTableEntry *p_entry)
+{
+	int list = T1;
+	bool inB2 = false;
+	if (p_paging->policy == ARC)
+	{
+		int b1Size = p_paging->lists[B1].size;
+		int b2Size = p_paging->lists[B2].size;
+		int ghostList = (p_entry->ghost == -1) ? NO_LIST : p_paging->nodeList[p_entry->ghost];
+		if (ghostList == B1)
+		{
+			// adapt the target size of T1 towards recency
+			int delta = (b2Size > b1Size) ? (b2Size / b1Size) : 1;
+			p_paging->arcTarget = (p_paging->arcTarget + delta < FRAMES) ? (p_paging->arcTarget + delta) : FRAMES;
+			removeGhost(p_paging, p_entry->ghost);
+			list = T2;
+		}
+		else if (ghostList == B2)
+		{
+			// adapt the target size of T1 towards frequency
+			int delta = (b1Size > b2Size) ? (b1Size / b2Size) : 1;
+			p_paging->arcTarget = (p_paging->arcTarget - delta > 0) ? (p_paging->arcTarget - delta) : 0;
+			removeGhost(p_paging, p_entry->ghost);
+			list = T2;
+			inB2 = true;
+		}
+		else if ((residentSize(p_paging, T1) + b1Size) >= FRAMES)
+		{
+			// L1 is full: forget the least recently used ghost of B1, or evict from T1
+			if (b1Size > 0)
+			{
+				removeGhost(p_paging, p_paging->lists[B1].head);
+			}
+			else if (p_paging->freeFramesCount == 0)
+			{
+				int victim = listVictim(p_paging, T1, processIndex);
+				evictFrame(p_paging, currentTime, p_processBufferStart, victim, false);
+				p_paging->freeFrames[p_paging->freeFramesCount++] = victim;
+			}
+		}
+		else if ((b1Size + b2Size + residentSize(p_paging, T1) + residentSize(p_paging, T2)) >= (2 * FRAMES) && (b2Size > 0))
+		{
+			removeGhost(p_paging, p_paging->lists[B2].head);
+		}
+	}
+	
+	int frame = getFreeFrame(p_paging, currentTime, p_processBufferStart, processIndex, inB2);
+	p_paging->frames[frame].processIndex = processIndex;
+	p_paging->frames[frame].page = page;
+	p_paging->frames[frame].referenced = true;
+	listAppend(p_paging, list, frame);
+	return frame;
+}
+
+// ==============================
+// address translation
+// ==============================
+
+// translates a virtual address and returns its latency in cycles
+int accessMemory(struct pagingState *p_paging, int currentTime, struct process *p_processBufferStart, int processIndex, int address)
+{
+	struct pagingProcess *p_pagingProcess = &p_paging->processes[processIndex];
+	int page = address / PAGE_SIZE;
+	p_paging->time++;
+	p_paging->accesses++;
+	p_pagingProcess->accesses++;
+
+	// TLB lookup
+	struct tlbEntry *set = p_paging->tlb[page % TLB_SETS];
+	int victim = 0;
+	for (int i = 0; i < TLB_WAYS; i++)
+	{
+		if (set[i].valid && (set[i].processIndex == processIndex) && (set[i].page == page))
+		{
+			set[i].lastUsed = p_paging->time;
+			p_paging->tlbHits++;
+			touchFrame(p_paging, set[i].frame);
+			return TLB_HIT_LATENCY;
+		}
+		if (!set[i].valid || (set[victim].valid && (set[i].lastUsed < set[victim].lastUsed)))
+		{
+			victim = i;
+		}
+	}
+
+	// page walk
+	int latency = TLB_HIT_LATENCY + 2 * PAGE_WALK_LATENCY;
+	struct pageTableEntry *p_entry = getPageTableEntry(p_pagingProcess, page);
+	if (p_entry->present)
+	{
+		touchFrame(p_paging, p_entry->frame);
+	}
+	else
+	{
+		// page fault
+		p_entry->frame = loadPage(p_paging, currentTime, p_processBufferStart, processIndex, page, p_entry);
+		p_entry->present = true;
+		p_paging->pageFaults++;
+		p_pagingProcess->pageFaults++;
+		latency += PAGE_FAULT_LATENCY;
+		writePagingLog(p_paging, currentTime, p_processBufferStart, processIndex, page, p_entry->frame, PAGE_FAULT);
+	}
+
+	// fill TLB
+	set[victim].valid = true;
+	set[victim].processIndex = processIndex;
+	set[victim].page = page;
+	set[victim].frame = p_entry->frame;
+	set[victim].lastUsed = p_paging->time;
+	return latency;
+}
+
+int nextAddress(struct pagingProcess *p_pagingProcess, struct process *p_process)
+{
+	switch (p_process->id % 3)
+	{
+		case SEQUENTIAL:
+			p_pagingProcess->lastAddress = (p_pagingProcess->lastAddress + sizeof(int)) % p_process->memSize;
+			break;
+
+		case RANDOM:
+			p_pagingProcess->lastAddress = rand_r(&p_pagingProcess->seed) % p_process->memSize;
+			break;
+
+		case LOCALITY:
+			// 90% of the accesses stay in a window of two pages around the last address
+			if ((rand_r(&p_pagingProcess->seed) % 10) != 0)
+			{
+				int offset = (rand_r(&p_pagingProcess->seed) % (2 * PAGE_SIZE)) - PAGE_SIZE;
+				p_pagingProcess->lastAddress = (p_pagingProcess->lastAddress + offset + p_process->memSize) % p_process->memSize;
+			}
+			else
+			{
+				p_pagingProcess->lastAddress = rand_r(&p_pagingProcess->seed) % p_process->memSize;
+			}
+			break;
+	}
+	return p_pagingProcess->lastAddress;
+}
+
+// simulates the memory accesses of a process during one tick with every replacement policy
+void simulateAccesses(int currentTime, struct process *p_processBufferStart, struct process *p_process)
+{
+	int processIndex = p_process - p_processBufferStart;
+	for (int policy = 0; policy < POLICIES; policy++)
+	{
+		struct pagingProcess *p_pagingProcess = &paging[policy].processes[processIndex];
+		if (paging[policy].runningIndex != processIndex)
+		{
+			restoreSkipped(&paging[policy], processIndex);
+		}
+		for (int i = 0; i < ACCESSES_PER_TICK; i++)
+		{
+			p_pagingProcess->latency += accessMemory(&paging[policy], currentTime, p_processBufferStart, processIndex, nextAddress(p_pagingProcess, p_process));
+		}
+	}
+}
+
+// frees the frames, the ghost entries and the page table of a finished process
+void releasePages(struct process *p_processBufferStart, struct process *p_process)
+{
+	int processIndex = p_process - p_processBufferStart;
+	for (int policy = 0; policy < POLICIES; policy++)
+	{
+		struct pagingState *p_paging = &paging[policy];
+		struct pagingProcess *p_pagingProcess = &p_paging->processes[processIndex];
+		if (p_pagingProcess->p_directory == NULL)
+		{
+			continue;
+		}
+
+		for (int i = 0; i < PAGE_DIRECTORY_ENTRIES; i++)
+		{
+			struct pageTableEntry *p_table = p_pagingProcess->p_directory->tables[i];
+			if (p_table == NULL)
+			{
+				continue;
+			}
+			for (int j = 0; j < PAGE_TABLE_ENTRIES; j++)
+			{
+				if (p_table[j].present)
+				{
+					if (p_paging->nodeList[p_table[j].frame] != NO_LIST)
+					{
+						listRemove(p_paging, p_table[j].frame);
+					}
+					p_paging->frames[p_table[j].frame].processIndex = -1;
+					p_paging->freeFrames[p_paging->freeFramesCount++] = p_table[j].frame;
+					invalidateTLB(p_paging, processIndex, (i * PAGE_TABLE_ENTRIES) + j);
+				}
+				if (p_table[j].ghost != -1)
+				{
+					removeGhost(p_paging, p_table[j].ghost);
+				}
+			}
+			free(p_table);
+		}
+		free(p_pagingProcess->p_directory);
+		p_pagingProcess->p_directory = NULL;
+	}
+}
+
+void writePagingPerformance(FILE *pFile, int N)
+{
+	struct pagingState *p_paging = &paging[REPLACEMENT_POLICY];
+	long latency = 0;
+	for (int i = 0; i < N; i++)
+	{
+		latency += p_paging->processes[i].latency;
+	}
+	fprintf(pFile, "Replacement policy = %s\n", policyNames[REPLACEMENT_POLICY]);
+	fprintf(pFile, "TLB hit rate = %.2f%%\n", (p_paging->accesses == 0) ? 0 : (p_paging->tlbHits / (float) p_paging->accesses) * 100);
+	fprintf(pFile, "Page faults = %ld\n", p_paging->pageFaults);
+	fprintf(pFile, "Evictions = %ld\n", p_paging->evictions);
+	fprintf(pFile, "Avg memory latency per process = %.2f cycles\n", latency / (float) N);
+	fprintf(pFile, "Avg fault latency per process = %.2f cycles\n", (p_paging->pageFaults * PAGE_FAULT_LATENCY) / (float) N);
+	for (int policy = 0; policy < POLICIES; policy++)
+	{
+		fprintf(pFile, "%s fault rate = %.2f%%\n", policyNames[policy], (paging[policy].accesses == 0) ? 0 : (paging[policy].pageFaults / (float) paging[policy].accesses) * 100);
+	}
+}
@@ -0,0 +1,152 @@
+// Streaming performance statistics. The mean and variance of each metric are updated with
+// Welford's method and its distribution is kept in a log-linear histogram (as in HDR histograms):
+// values below HISTOGRAM_SUB_BUCKETS have their own bucket and larger values share a bucket with
+// values of the same HISTOGRAM_SUB_BUCKET_BITS leading bits, so percentiles are within 1/64 of the
+// true value and the memory used does not depend on the number of processes.
+
+// precision of the histogram (can be overridden with -D)
+#ifndef HISTOGRAM_SUB_BUCKET_BITS
+#define HISTOGRAM_SUB_BUCKET_BITS 7
+#endif
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BUCKET_BITS)
+#define HISTOGRAM_HALF_BUCKETS (HISTOGRAM_SUB_BUCKETS / 2)
+
+// enough buckets for any non-negative int
+#define HISTOGRAM_SIZE ((33 - HISTOGRAM_SUB_BUCKET_BITS) * HISTOGRAM_HALF_BUCKETS)
+
+// fractional metrics are stored in the histogram in thousandths
+#define WTA_SCALE 1000
+
+struct streamingStats
+{
+	long count;
+	double mean;
+	double m2;
+	double min;
+	double max;
+	int scale;
+	long histogram[HISTOGRAM_SIZE];
+};
+
+struct performanceStats
+{
+	struct streamingStats weightedTurnaround;
+	struct streamingStats waiting;
+	struct streamingStats response;
+	struct streamingStats turnaround;
+};
+
+struct performanceStats performance;
+
+void initStreamingStats(struct streamingStats *p_stats, int scale)
+{
+	p_stats->count = 0;
+	p_stats->mean = 0;
+	p_stats->m2 = 0;
+	p_stats->scale = scale;
+	for (int i = 0; i < HISTOGRAM_SIZE; i++)
+	{
+		p_stats->histogram[i] = 0;
+	}
+}
+
+void initPerformanceStats()
+{
+	initStreamingStats(&performance.weightedTurnaround, WTA_SCALE);
+	initStreamingStats(&performance.waiting, 1);
+	initStreamingStats(&performance.response, 1);
+	initStreamingStats(&performance.turnaround, 1);
+}
+
+int histogramIndex(int value)
+{
+	if (value < HISTOGRAM_SUB_BUCKETS)
+	{
+		return value;
+	}
+	// shift the value so that it has HISTOGRAM_SUB_BUCKET_BITS bits
+	int shift = (31 - __builtin_clz(value)) - (HISTOGRAM_SUB_BUCKET_BITS - 1);
+	return shift * HISTOGRAM_HALF_BUCKETS + (value >> shift);
+}
+
+// returns the middle of the range of values in a bucket
+double histogramValue(int index)
+{
+	if (index < HISTOGRAM_SUB_BUCKETS)
+	{
+		return index;
+	}
+	int shift = index / HISTOGRAM_HALF_BUCKETS - 1;
+	long lowest = (long) (index - shift * HISTOGRAM_HALF_BUCKETS) << shift;
+	return lowest + ((1L << shift) - 1) / 2.0;
+}
+
+void addSample(struct streamingStats *p_stats, double value)
+{
+	// Welford's method
+	p_stats->count++;
+	double delta = value - p_stats->mean;
+	p_stats->mean += delta / p_stats->count;
+	p_stats->m2 += delta * (value - p_stats->mean);
+	if ((p_stats->count == 1) || (value < p_stats->min))
+	{
+		p_stats->min = value;
+	}
+	if ((p_stats->count == 1) || (value > p_stats->max))
+	{
+		p_stats->max = value;
+	}
+
+	int scaled = (int) (value * p_stats->scale + 0.5);
+	p_stats->histogram[histogramIndex((scaled < 0) ? 0 : scaled)]++;
+}
+
+double standardDeviation(struct streamingStats *p_stats)
+{
+	return (p_stats->count == 0) ? 0 : sqrt(p_stats->m2 / p_stats->count);
+}
+
+double percentile(struct streamingStats *p_stats, double p)
+{
+	if (p_stats->count == 0)
+	{
+		return 0;
+	}
+	long rank = (long) ceil(p / 100 * p_stats->count);
+	if (rank < 1)
+	{
+		rank = 1;
+	}
+	long seen = 0;
+	for (int i = 0; i < HISTOGRAM_SIZE; i++)
+	{
+		seen += p_stats->histogram[i];
+		if (seen >= rank)
+		{
+			// the true value is within the observed range
+			double value = histogramValue(i) / p_stats->scale;
+			return (value < p_stats->min) ? p_stats->min : (value > p_stats->max) ? p_stats->max : value;
+		}
+	}
+	return p_stats->max;
+}
+
+// the response time is the waiting time when a process starts, the others are taken when it finishes
+void recordPerformance(int currentTime, struct PCB *p_PCB, int logType)
+{
+	if (logType == STARTED)
+	{
+		addSample(&performance.response, p_PCB->waitingTime);
+	}
+	else if (logType == FINISHED)
+	{
+		addSample(&performance.weightedTurnaround, (currentTime - p_PCB->arrivalTime) / (float) p_PCB->executionTime);
+		addSample(&performance.waiting, p_PCB->waitingTime);
+		addSample(&performance.turnaround, currentTime - p_PCB->arrivalTime);
+	}
+}
+
+void writeStreamingStats(FILE *pFile, char *name, struct streamingStats *p_stats)
+{
+	fprintf(pFile, "%s: avg %.2f, std %.2f, p50 %.2f, p90 %.2f, p99 %.2f, p99.9 %.2f, max %.2f\n", name, p_stats->mean, standardDeviation(p_stats), percentile(p_stats, 50), percentile(p_stats, 90), percentile(p_stats, 99), percentile(p_stats, 99.9), p_stats->max);
+}
@@ -1,5 +1,11 @@
 #include "headers.h"
 #include "scheduler_utilities.h"
+#ifdef REAL_MEMORY
+#include "real_memory.h"
+#endif
+#ifdef DYNAMIC_ALLOCATION
+#include "dynamic_allocation.h"
+#endif
 
 int main(int agrc, char * argv[])
 {
@@ -11,14 +17,40 @@ int main(int agrc, char * argv[])
 	struct PCB *p_PCB = shmat(PCB_shmid, (void *)0, 0);
 	
 	// get semaphore between scheduler and process
-	int PCB_sem = semget(PCB_SEM_KEY, 1, IPC_CREAT | 0644);
+	int PCB_sem = semget(ipcKey(PCB_SEM_KEY), 1, IPC_CREAT | 0644);
 	
 	// wait for scheduler to initialize PCB
 	down(PCB_sem);
 
+	#ifdef REAL_MEMORY
+		// touch the allocated range of the real memory once per clock tick while running
+		struct realMemoryStats *p_realMemory = NULL;
+		unsigned int seed = getpid();
+		int lastTouchTime = -1;
+	#endif
+	#ifdef DYNAMIC_ALLOCATION
+		// submit allocation requests while running
+		struct requestGenerator generator;
+		initRequestGenerator(&generator, p_PCB->id);
+	#endif
 	int remainingtime = p_PCB->remainingTime;
 	while (remainingtime > 0)
 	{
+		#ifdef REAL_MEMORY
+			int currentTime = getClk();
+			if ((p_PCB->state == RUNNING) && (p_PCB->memorySize > 0) && (currentTime != lastTouchTime))
+			{
+				if (p_realMemory == NULL)
+				{
+					p_realMemory = mapRealMemory(p_PCB->memoryFd);
+				}
+				touchRealMemory(p_realMemory, p_PCB->memoryStart, p_PCB->memorySize, &seed);
+				lastTouchTime = currentTime;
+			}
+		#endif
+		#ifdef DYNAMIC_ALLOCATION
+			submitRequests(p_PCB, &generator, getClk());
+		#endif
 		remainingtime = p_PCB->remainingTime;
 	}
 
@@ -1,5 +1,12 @@
 #include "headers.h"
 #include "scheduler_utilities.h"
+#ifdef DYNAMIC_ALLOCATION
+#include "dynamic_allocation.h"
+#endif
+#include "generator.h"
+#ifdef CHECKPOINT
+#include "checkpoint_file.h"
+#endif
 
 // definitions
 #define CLK_PROCESS "./clk.out"
@@ -18,68 +25,82 @@ int main(int argc, char * argv[])
 {
 	signal(SIGINT, clearResources);
 
-	// open file
-	FILE *pFile = fopen(argv[1], "r");    
-	if (pFile == NULL)
+	// select the memory allocator (buddy system by default)
+	if (argc > 2)
 	{
-		printf("Could not open file %s\n", argv[1]);
-		return -1;
-	}
-
-	// count number of processes in simulation
-	int N = -1;
-	char c;
-	for (c = getc(pFile); c != EOF; c = getc(pFile))
-	{
-		if (c == '\n')
+		allocatorType = allocatorFromName(argv[2]);
+		if (allocatorType == -1)
 		{
-			N += 1;
+			printf("Unknown allocator %s (buddy, first-fit, best-fit, next-fit, tlsf or buddy-slab)\n", argv[2]);
+			return -1;
 		}
 	}
-	fclose(pFile);
 
-	// read input file and create an array of processes
-	pFile = fopen(argv[1], "r");
-	processArray = (struct process *) malloc(N * sizeof(struct process));
-	fscanf(pFile, "%*[^\n]\n");
-	for (int i = 0; i < N; i++)
+	// select the scheduling algorithm and quantum without asking (asked at startup otherwise)
+	int type = -1;
+	int quantum = 0;
+	if (argc > 3)
 	{
-		fscanf(pFile, "%d\t%d\t%d\t%d\t%d\n", &processArray[i].id, &processArray[i].arrivalTime, &processArray[i].runningTime, &processArray[i].priority, &processArray[i].memSize);
-		processArray[i].remainingTime = processArray[i].runningTime;
-		if (processArray[i].memSize > SMALLEST_ALLOCATION_UNIT)
+		type = schedulerFromName(argv[3]);
+		if (type == -1)
 		{
-			processArray[i].allocationSize = pow(2, ceil(log2f((float) processArray[i].memSize)));
+			printf("Unknown scheduling algorithm %s (hpf, srtn or rr)\n", argv[3]);
+			return -1;
 		}
-		else
+		if (type == RR)
 		{
-			processArray[i].allocationSize = SMALLEST_ALLOCATION_UNIT;
+			quantum = (argc > 4) ? atoi(argv[4]) : 0;
+			if (quantum < 1)
+			{
+				printf("Round robin needs a quantum of at least 1\n");
+				return -1;
+			}
 		}
-		processArray[i].allocatedMemUnit = NULL;
-		processArray[i].next = -1;
-		processArray[i].prev = -1;
 	}
-	fclose(pFile);
+
+	// read the workload
+	int N = 0;
+	processArray = readWorkload(argv[1], &N);
+	if (processArray == NULL)
+	{
+		return -1;
+	}
+
+	#ifdef CHECKPOINT
+		// a checkpoint continues the simulation of the same workload
+		struct checkpointHeader *p_checkpoint = resumeCheckpoint();
+		if ((p_checkpoint != NULL) && ((p_checkpoint->N != N) || (p_checkpoint->memorySize != MEMORY_SIZE) || (p_checkpoint->sharedSize != (long) SHARED_MEMORY_SIZE(N))))
+		{
+			printf("The checkpoint does not match workload %s\n", argv[1]);
+			return -1;
+		}
+	#endif
 
 	// create shared memory between scheduler and generator to hold the simulation size
-	simSize_shmid = shmget(SIM_SIZE_SHM_KEY, sizeof(int), IPC_CREAT | 0644);
+	simSize_shmid = shmget(ipcKey(SIM_SIZE_SHM_KEY), sizeof(int), IPC_CREAT | 0644);
 	int *p_simSize = shmat(simSize_shmid, (void *)0, 0);
 	*p_simSize = N; // Total number of processes in simulation
 
 	// create shared memory between scheduler and generator
-	scheduler_shmid = shmget(SCHEDULER_SHM_KEY, (sizeof(struct schedulerInfo) + sizeof(struct readyQueue) + (N * sizeof(struct process))), IPC_CREAT | 0644); 
+	scheduler_shmid = shmget(ipcKey(SCHEDULER_SHM_KEY), SHARED_MEMORY_SIZE(N), IPC_CREAT | 0644); 
 	struct schedulerInfo *p_schedulerInfo = (struct schedulerInfo *) shmat(scheduler_shmid, (void *) 0, 0);
-	struct readyQueue *p_readyQueue = (struct readyQueue *) (p_schedulerInfo + 1);
-	struct process *p_processBufferStart = (struct processs *) (p_readyQueue + 1);
 	
 	// initialize shared memory
-	p_schedulerInfo->generationFinished = false;
-	p_schedulerInfo->quantum = 0;
-	p_readyQueue->head = -1;
-	p_readyQueue->tail = -1;
-	p_readyQueue->processArrival = false;
+	initSchedulerInfo(p_schedulerInfo, N);
+	int processIndex = 0;
+	#ifdef CHECKPOINT
+		if (p_checkpoint != NULL)
+		{
+			// restore the ready queue and the processes that arrived, with the algorithm and quantum
+			resumeShared(p_schedulerInfo);
+			processIndex = p_checkpoint->arrivedProcesses;
+			type = p_schedulerInfo->schedulerType;
+			quantum = p_schedulerInfo->quantum;
+		}
+	#endif
 	
 	// create sempahore between scheduler and generator
-	scheduler_sem = semget(SCHEDULER_SEM_KEY, 1, IPC_CREAT | 0644);
+	scheduler_sem = semget(ipcKey(SCHEDULER_SEM_KEY), 1, IPC_CREAT | 0644);
 	union Semun semun;
 	semun.val = 0;
 	if (semctl(scheduler_sem, 0, SETVAL, semun) == -1)
@@ -89,17 +110,18 @@ int main(int argc, char * argv[])
 	}
 	
 	// ask the user for the chosen algorithm
-	int type;
-	printf("Choose a scheduling algorithm (0:HPF 1:SRTN 2:RR): ");
-	scanf("%d", &type);
-	p_schedulerInfo->schedulerType = type;
-	if (p_schedulerInfo->schedulerType == RR)
+	if (type == -1)
 	{
-		int q;
-		printf("Determine a quantum value: ");
-		scanf("%d", &q);
-		p_schedulerInfo->quantum = q;
+		printf("Choose a scheduling algorithm (0:HPF 1:SRTN 2:RR): ");
+		scanf("%d", &type);
+		if (type == RR)
+		{
+			printf("Determine a quantum value: ");
+			scanf("%d", &quantum);
+		}
 	}
+	p_schedulerInfo->schedulerType = type;
+	p_schedulerInfo->quantum = quantum;
 
 	// initiate and create the scheduler and clock processes.
 	int scheduler_pid = createProcess(SCHEDULER_PROCESS);
@@ -111,8 +133,6 @@ int main(int argc, char * argv[])
 	printf("Current time is %d\n", currentTime);
 	
 	// generation main loop
-	int processIndex = 0;
-	struct process *p_process = (struct process *) (p_readyQueue + 1);
 	while (1)
 	{
 		#ifdef PRINTING
@@ -120,27 +140,8 @@ int main(int argc, char * argv[])
 			printf("TIME STEP %d\n", currentTime);
 			printf("============\n");
 		#endif	
-		if (!p_schedulerInfo->generationFinished)
-		{
-			// send the information to the scheduler in its appropriate time
-			while (processArray[processIndex].arrivalTime == currentTime)
-			{			 
-				*p_process = processArray[processIndex]; // physical allocation
-				enqueue(p_readyQueue, p_processBufferStart, p_process, processIndex, p_schedulerInfo->schedulerType);
-				p_readyQueue->processArrival = true;
-				#ifdef PRINTING
-					printf("Process Generator: Process %d arrived\n", p_process->id);
-				#endif	
-				
-				if ((processIndex + 1) == N)
-				{
-					p_schedulerInfo->generationFinished = true;
-					break;
-				}
-				p_process += 1;
-				processIndex++;
-			}
-		}
+		// send the information to the scheduler in its appropriate time
+		generateArrivals(p_schedulerInfo, processArray, N, &processIndex, currentTime);
 					
 		// enable scheduler to operate on the ready queue
 		up(scheduler_sem);
@@ -0,0 +1,123 @@
+#include "headers.h"
+#include "scheduler_utilities.h"
+#include <time.h>
+
+// queue sizes to benchmark
+#define SIZES_COUNT 6
+int sizes[SIZES_COUNT] = {64, 256, 1024, 4096, 16384, 32768};
+
+// number of operations in the churn benchmark
+#define CHURN_OPERATIONS 20000
+
+double getTime()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+struct readyQueue *createQueue(int N)
+{
+	// allocate a buffer with the same layout as the shared memory
+	struct readyQueue *p_readyQueue = (struct readyQueue *) malloc(sizeof(struct readyQueue) + PROCESS_BUFFER_SIZE(N));
+	struct process *p_processBufferStart = (struct process *) (p_readyQueue + 1);
+	p_readyQueue->head = -1;
+	p_readyQueue->tail = -1;
+	p_readyQueue->processArrival = false;
+	p_readyQueue->size = N;
+	p_readyQueue->count = 0;
+	p_readyQueue->sequence = 0;
+	p_readyQueue->schedulerType = -1;
+
+	// generate random processes
+	srand(N);
+	for (int i = 0; i < N; i++)
+	{
+		struct process *p_process = p_processBufferStart + i;
+		p_process->id = i + 1;
+		p_process->arrivalTime = 0;
+		p_process->runningTime = rand() % 30 + 1;
+		p_process->priority = rand() % 11;
+		p_process->remainingTime = p_process->runningTime;
+		p_process->memSize = rand() % 255 + 1;
+		p_process->allocationSize = SMALLEST_ALLOCATION_UNIT;
+		p_process->allocatedMemUnit = NULL;
+		p_process->next = -1;
+		p_process->prev = -1;
+	}
+	return p_readyQueue;
+}
+
+// enqueues N processes then empties the queue from its head
+double benchmarkEnqueue(int N, int schedulerType)
+{
+	struct readyQueue *p_readyQueue = createQueue(N);
+	struct process *p_processBufferStart = (struct process *) (p_readyQueue + 1);
+
+	// enqueue all processes then empty the queue from its head
+	double start = getTime();
+	for (int i = 0; i < N; i++)
+	{
+		enqueue(p_readyQueue, p_processBufferStart, p_processBufferStart + i, i, schedulerType);
+	}
+	while (p_readyQueue->head != -1)
+	{
+		dequeue(p_readyQueue, p_processBufferStart, p_processBufferStart + p_readyQueue->head);
+	}
+	double elapsed = getTime() - start;
+
+	free(p_readyQueue);
+	return elapsed * 1e9 / N;
+}
+
+// keeps N processes queued and repeatedly requeues the head with a new key
+double benchmarkChurn(int N, int schedulerType)
+{
+	struct readyQueue *p_readyQueue = createQueue(N);
+	struct process *p_processBufferStart = (struct process *) (p_readyQueue + 1);
+	for (int i = 0; i < N; i++)
+	{
+		enqueue(p_readyQueue, p_processBufferStart, p_processBufferStart + i, i, schedulerType);
+	}
+
+	double start = getTime();
+	for (int i = 0; i < CHURN_OPERATIONS; i++)
+	{
+		int processIndex = p_readyQueue->head;
+		struct process *p_process = p_processBufferStart + processIndex;
+		dequeue(p_readyQueue, p_processBufferStart, p_process);
+		p_process->priority = rand() % 11;
+		p_process->remainingTime = rand() % 30 + 1;
+		enqueue(p_readyQueue, p_processBufferStart, p_process, processIndex, schedulerType);
+	}
+	double elapsed = getTime() - start;
+
+	free(p_readyQueue);
+	return elapsed * 1e9 / CHURN_OPERATIONS;
+}
+
+int main(int argc, char * argv[])
+{
+	#if defined(SOA_LAYOUT)
+		printf("Layout: structure of arrays\n");
+	#elif defined(ARRAY_READY_QUEUE) && defined(__AVX2__)
+		printf("Layout: array-backed ready queue (AVX2)\n");
+	#elif defined(ARRAY_READY_QUEUE) && defined(__SSE4_1__)
+		printf("Layout: array-backed ready queue (SSE4.1)\n");
+	#elif defined(ARRAY_READY_QUEUE)
+		printf("Layout: array-backed ready queue (scalar)\n");
+	#else
+		printf("Layout: array of structures\n");
+	#endif
+	printf("%-10s %-14s %-14s %-14s %-14s\n", "size", "HPF fill", "SRTN fill", "HPF churn", "SRTN churn");
+	for (int i = 0; i < SIZES_COUNT; i++)
+	{
+		double hpf = benchmarkEnqueue(sizes[i], HPF);
+		double srtn = benchmarkEnqueue(sizes[i], SRTN);
+		double hpfChurn = benchmarkChurn(sizes[i], HPF);
+		double srtnChurn = benchmarkChurn(sizes[i], SRTN);
+		printf("%-10d %-14.1f %-14.1f %-14.1f %-14.1f\n", sizes[i], hpf, srtn, hpfChurn, srtnChurn);
+	}
+	printf("(ns per process for fill, ns per requeue for churn)\n");
+	return 0;
+}
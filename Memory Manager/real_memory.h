@@ -0,0 +1,144 @@
+// Real memory backing. The scheduler creates a shared memory file (memfd, with huge pages when
+// available) in which every simulated byte is backed by REAL_MEMORY_SCALE real bytes. The
+// running process reads and writes its allocated range with an access pattern and adds the
+// number of accesses and the time they took to the statistics at the start of the file.
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/memfd.h>
+#include <time.h>
+
+// real bytes per simulated byte (can be overridden with -D)
+#ifndef REAL_MEMORY_SCALE
+#define REAL_MEMORY_SCALE 4096
+#endif
+
+// access patterns
+#define REAL_ACCESS_SEQUENTIAL 0
+#define REAL_ACCESS_STRIDED 1
+#define REAL_ACCESS_RANDOM 2
+#ifndef ACCESS_PATTERN
+#define ACCESS_PATTERN REAL_ACCESS_SEQUENTIAL
+#endif
+
+// access granularity and stride of the strided pattern
+#define CACHE_LINE 64
+#define ACCESS_STRIDE 4096
+
+// huge page size used to align the statistics header
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+struct realMemoryStats
+{
+	long accesses;
+	long nanoseconds;
+	int hugePages;
+};
+
+#define REAL_MEMORY_HEADER HUGE_PAGE_SIZE
+#define REAL_MEMORY_SIZE (REAL_MEMORY_HEADER + (long) MEMORY_SIZE * REAL_MEMORY_SCALE)
+
+// creates the backing file and returns its descriptor, which is inherited by the processes
+int createRealMemory()
+{
+	// try huge pages first
+	int fd = syscall(SYS_memfd_create, "simulated-memory", MFD_HUGETLB);
+	if ((fd != -1) && (ftruncate(fd, REAL_MEMORY_SIZE) == -1))
+	{
+		close(fd);
+		fd = -1;
+	}
+	if (fd != -1)
+	{
+		void *p_probe = mmap(NULL, REAL_MEMORY_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (p_probe == MAP_FAILED)
+		{
+			close(fd);
+			fd = -1;
+		}
+		else
+		{
+			((struct realMemoryStats *) p_probe)->hugePages = true;
+			munmap(p_probe, REAL_MEMORY_SIZE);
+		}
+	}
+
+	if (fd == -1)
+	{
+		fd = syscall(SYS_memfd_create, "simulated-memory", 0);
+		if ((fd == -1) || (ftruncate(fd, REAL_MEMORY_SIZE) == -1))
+		{
+			perror("Error in creating real memory");
+			exit(-1);
+		}
+	}
+	return fd;
+}
+
+struct realMemoryStats *mapRealMemory(int fd)
+{
+	void *p_memory = mmap(NULL, REAL_MEMORY_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (p_memory == MAP_FAILED)
+	{
+		perror("Error in mapping real memory");
+		exit(-1);
+	}
+	return (struct realMemoryStats *) p_memory;
+}
+
+long getNanoseconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+// reads and writes one cache line per access over the range of simulated bytes [start, start + size)
+void touchRealMemory(struct realMemoryStats *p_stats, int start, int size, unsigned int *p_seed)
+{
+	volatile unsigned char *p_range = (unsigned char *) p_stats + REAL_MEMORY_HEADER + (long) start * REAL_MEMORY_SCALE;
+	long length = (long) size * REAL_MEMORY_SCALE;
+	long accesses = 0;
+	long startTime = getNanoseconds();
+	switch (ACCESS_PATTERN)
+	{
+		case REAL_ACCESS_SEQUENTIAL:
+			for (long offset = 0; offset < length; offset += CACHE_LINE)
+			{
+				p_range[offset]++;
+				accesses++;
+			}
+			break;
+
+		case REAL_ACCESS_STRIDED:
+			for (long column = 0; column < ACCESS_STRIDE; column += CACHE_LINE)
+			{
+				for (long offset = column; offset < length; offset += ACCESS_STRIDE)
+				{
+					p_range[offset]++;
+					accesses++;
+				}
+			}
+			break;
+
+		case REAL_ACCESS_RANDOM:
+			for (long i = 0; i < length / CACHE_LINE; i++)
+			{
+				// xorshift
+				*p_seed ^= *p_seed << 13;
+				*p_seed ^= *p_seed >> 17;
+				*p_seed ^= *p_seed << 5;
+				p_range[(*p_seed % (length / CACHE_LINE)) * CACHE_LINE]++;
+				accesses++;
+			}
+			break;
+	}
+	__atomic_fetch_add(&p_stats->accesses, accesses, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&p_stats->nanoseconds, getNanoseconds() - startTime, __ATOMIC_RELAXED);
+}
+
+void writeRealMemoryPerformance(FILE *pFile, struct realMemoryStats *p_stats)
+{
+	fprintf(pFile, "Real memory = %ld bytes (%s)\n", (long) MEMORY_SIZE * REAL_MEMORY_SCALE, p_stats->hugePages ? "huge pages" : "normal pages");
+	fprintf(pFile, "Real memory accesses = %ld\n", p_stats->accesses);
+	fprintf(pFile, "Avg access time = %.2f ns\n", (p_stats->accesses == 0) ? 0 : p_stats->nanoseconds / (double) p_stats->accesses);
+}
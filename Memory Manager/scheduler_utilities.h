@@ -1,3 +1,5 @@
+#include <limits.h>
+
 // scheduling algorithms
 #define HPF 0
 #define SRTN 1
@@ -27,37 +29,84 @@
 // memory log states
 #define ALLOCATED 0
 #define FREED 1
+#define SWAPPED_OUT 2
+#define SWAPPED_IN 3
 
 // smallest allocation unit
 #define SMALLEST_ALLOCATION_UNIT 8
 
+// total memory size, a power of two (can be overridden with -D)
+#ifndef MEMORY_SIZE
+#define MEMORY_SIZE 1024
+#endif
+
+// number of allocation sizes from SMALLEST_ALLOCATION_UNIT to MEMORY_SIZE
+#define ALLOCATION_ORDERS (__builtin_ctz(MEMORY_SIZE / SMALLEST_ALLOCATION_UNIT) + 1)
+
+// maximum number of memory units in the buddy tree
+#define MEMORY_UNITS ((1 << ALLOCATION_ORDERS) - 1)
+
+// memory allocators
+#define BUDDY 0
+#define FIRST_FIT 1
+#define BEST_FIT 2
+#define NEXT_FIT 3
+#define TLSF 4
+#define BUDDY_SLAB 5
+#define ALLOCATORS 6
+
 // memory unit states
 #define EMPTY -1
 #define NOT_EMPTY 0
 
+// dynamic allocation request types
+#define MALLOC 0
+#define FREE 1
+
+// size of the allocation request ring of each process
+#define REQUEST_RING_SIZE 32
+
 struct waitingProcess
 {
 	struct process *p_process;
+	int sequence;
 	struct waitingProcess *next;
 	struct waitingProcess *prev;
 };
 
-struct waitingQueue
+struct waitingClass
 {
 	struct waitingProcess *head;
 	struct waitingProcess *tail;
 };
 
+// The waiting list holds one FIFO per allocation size so that only the sizes that
+// can fit in the largest free memory unit are tried.
+struct waitingQueue
+{
+	struct waitingClass classes[ALLOCATION_ORDERS];
+	int count;
+	int sequence;
+};
+
 struct memUnit
 {
 	int id;
 	int size;
 	int start;
+	int largestFree;	// size of the largest free memory unit in this subtree
 	struct memUnit *parent;
 	struct memUnit *left;
 	struct memUnit *right;
 };
 
+struct allocationRequest
+{
+	int type;
+	int size;
+	int block;	// handle of the block (returned by the memory manager for MALLOC)
+};
+
 struct PCB
 {
 	int id;
@@ -67,6 +116,18 @@ struct PCB
 	int remainingTime;
 	int waitingTime;
 	int priority;
+	#ifdef REAL_MEMORY
+		int memoryFd;	// real memory backing and the allocated range of the process in it
+		int memoryStart;
+		int memorySize;
+	#endif
+	#ifdef DYNAMIC_ALLOCATION
+		int requestRate;	// allocation requests per time step and their mean size in bytes
+		int requestSize;
+		int requestHead;	// next request to service (written by the memory manager)
+		int requestTail;	// next free slot (written by the process)
+		struct allocationRequest requests[REQUEST_RING_SIZE];
+	#endif
 };
 
 struct process
@@ -81,13 +142,21 @@ struct process
 	struct memUnit *allocatedMemUnit;
 	int next;
 	int prev;	
+	#ifdef DYNAMIC_ALLOCATION
+		int requestRate;
+		int requestSize;
+	#endif
 };
 
 struct schedulerInfo
 {
 	int schedulerType;
 	int quantum;
+	int allocatorType;
 	bool generationFinished;
+	#ifdef HOT_PATH_STATS
+		struct hotPathStats generatorHotPath;	// published by the process generator
+	#endif
 };
 
 struct readyQueue
@@ -95,10 +164,394 @@ struct readyQueue
 	int head;
 	int tail;
 	bool processArrival;
+	int size;
+	int count;		// array-backed ready queue only
+	int sequence;		// array-backed ready queue only
+	int schedulerType;	// array-backed ready queue only
 };
 
+#if defined(SOA_LAYOUT) && defined(ARRAY_READY_QUEUE)
+#error "SOA_LAYOUT and ARRAY_READY_QUEUE cannot be used together"
+#endif
+
+#if defined(DYNAMIC_ALLOCATION) && (defined(COMPACTION) || defined(SWAPPING))
+#error "DYNAMIC_ALLOCATION cannot be used with COMPACTION or SWAPPING"
+#endif
+
+// size of the shared process buffer
+#ifdef SOA_LAYOUT
+#define PROCESS_BUFFER_SIZE(N) ((N) * (sizeof(struct process) + 4 * sizeof(int)))
+#elif defined(ARRAY_READY_QUEUE)
+#define PROCESS_BUFFER_SIZE(N) ((N) * (sizeof(struct process) + 3 * sizeof(int)))
+#else
+#define PROCESS_BUFFER_SIZE(N) ((N) * sizeof(struct process))
+#endif
+
+// The memory shared between the generator and the scheduler holds the scheduler info, the ready
+// queue and the process buffer, which starts at the next offset aligned for struct process.
+#define PROCESS_BUFFER_OFFSET ((sizeof(struct schedulerInfo) + sizeof(struct readyQueue) + _Alignof(struct process) - 1) / _Alignof(struct process) * _Alignof(struct process))
+#define SHARED_MEMORY_SIZE(N) (PROCESS_BUFFER_OFFSET + PROCESS_BUFFER_SIZE(N))
+
+struct process *sharedProcessBuffer(struct schedulerInfo *p_schedulerInfo)
+{
+	return (struct process *) ((char *) p_schedulerInfo + PROCESS_BUFFER_OFFSET);
+}
+
+#ifdef SOA_LAYOUT
+// The hot scheduling fields are stored as separate arrays after the process buffer so that
+// the comparison walk in enqueue() only touches the keys and the links. The fields in
+// struct process are kept in sync for the nodes touched by enqueue() and dequeue().
+struct hotFields
+{
+	int *priority;
+	int *remainingTime;
+	int *next;
+	int *prev;
+};
+
+struct hotFields getHotFields(struct readyQueue *p_readyQueue, struct process *p_processBufferStart)
+{
+	struct hotFields hot;
+	hot.priority = (int *) (p_processBufferStart + p_readyQueue->size);
+	hot.remainingTime = hot.priority + p_readyQueue->size;
+	hot.next = hot.remainingTime + p_readyQueue->size;
+	hot.prev = hot.next + p_readyQueue->size;
+	return hot;
+}
+
+void setNext(struct hotFields *p_hot, struct process *p_processBufferStart, int processIndex, int nextIndex)
+{
+	p_hot->next[processIndex] = nextIndex;
+	p_processBufferStart[processIndex].next = nextIndex;
+}
+
+void setPrev(struct hotFields *p_hot, struct process *p_processBufferStart, int processIndex, int prevIndex)
+{
+	p_hot->prev[processIndex] = prevIndex;
+	p_processBufferStart[processIndex].prev = prevIndex;
+}
+
+void enqueue(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process *p_process, int processIndex, int schedulerType)
+{
+	HOT_PATH_TIMER(ENQUEUE_OPERATION);
+	struct hotFields hot = getHotFields(p_readyQueue, p_processBufferStart);
+	hot.priority[processIndex] = p_process->priority;
+	hot.remainingTime[processIndex] = p_process->remainingTime;
+	
+	// find the neighbours of the new process
+	int prevIndex = -1;
+	int nextIndex = p_readyQueue->head;
+	if (schedulerType == RR)
+	{
+		prevIndex = p_readyQueue->tail;
+		nextIndex = -1;
+	}
+	else
+	{
+		int *key = (schedulerType == HPF) ? hot.priority : hot.remainingTime;
+		int processKey = key[processIndex];
+		while ((nextIndex != -1) && (key[nextIndex] <= processKey))
+		{
+			HOT_PATH_WORK(ENQUEUE_OPERATION, 1);
+			prevIndex = nextIndex;
+			nextIndex = hot.next[nextIndex];
+		}
+	}
+	
+	// link process
+	setPrev(&hot, p_processBufferStart, processIndex, prevIndex);
+	setNext(&hot, p_processBufferStart, processIndex, nextIndex);
+	if (prevIndex == -1)
+	{
+		p_readyQueue->head = processIndex;
+	}
+	else
+	{
+		setNext(&hot, p_processBufferStart, prevIndex, processIndex);
+	}
+	if (nextIndex == -1)
+	{
+		p_readyQueue->tail = processIndex;
+	}
+	else
+	{
+		setPrev(&hot, p_processBufferStart, nextIndex, processIndex);
+	}
+}
+
+void dequeue(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process *p_process)
+{
+	HOT_PATH_TIMER(DEQUEUE_OPERATION);
+	struct hotFields hot = getHotFields(p_readyQueue, p_processBufferStart);
+	int processIndex = p_process - p_processBufferStart;
+	int prevIndex = hot.prev[processIndex];
+	int nextIndex = hot.next[processIndex];
+	
+	if (prevIndex == -1)
+	{
+		p_readyQueue->head = nextIndex;
+	}
+	else
+	{
+		setNext(&hot, p_processBufferStart, prevIndex, nextIndex);
+	}
+	if (nextIndex == -1)
+	{
+		p_readyQueue->tail = prevIndex;
+	}
+	else
+	{
+		setPrev(&hot, p_processBufferStart, nextIndex, prevIndex);
+	}
+}
+
+void decrementRemainingTime(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process *p_process)
+{
+	struct hotFields hot = getHotFields(p_readyQueue, p_processBufferStart);
+	p_process->remainingTime--;
+	hot.remainingTime[p_process - p_processBufferStart] = p_process->remainingTime;
+}
+
+// returns the index of the process after processIndex in the ready queue, -1 if it is the last one
+int nextInReadyQueue(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, int processIndex)
+{
+	struct hotFields hot = getHotFields(p_readyQueue, p_processBufferStart);
+	return hot.next[processIndex];
+}
+#elif defined(ARRAY_READY_QUEUE)
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+// The ready queue is stored as a packed array of keys (priority for HPF, remaining time for
+// SRTN and enqueue order for RR) after the process buffer. The head is the process with the
+// smallest key, ties are broken by arrival order (process index). The next and prev fields
+// of struct process are not used.
+struct arrayQueue
+{
+	int *keys;	// key of each queued process
+	int *slots;	// process index of each queued process
+	int *position;	// position of each process in keys and slots
+};
+
+struct arrayQueue getArrayQueue(struct readyQueue *p_readyQueue, struct process *p_processBufferStart)
+{
+	struct arrayQueue queue;
+	queue.keys = (int *) (p_processBufferStart + p_readyQueue->size);
+	queue.slots = queue.keys + p_readyQueue->size;
+	queue.position = queue.slots + p_readyQueue->size;
+	return queue;
+}
+
+// returns the smallest key of the array
+int minKey(int *keys, int count)
+{
+	int i = 0;
+	int minimum = INT_MAX;
+	#if defined(__AVX2__)
+		__m256i minimum8 = _mm256_set1_epi32(INT_MAX);
+		for (; i + 8 <= count; i += 8)
+		{
+			minimum8 = _mm256_min_epi32(minimum8, _mm256_loadu_si256((__m256i *) (keys + i)));
+		}
+		int lanes[8];
+		_mm256_storeu_si256((__m256i *) lanes, minimum8);
+		for (int j = 0; j < 8; j++)
+		{
+			minimum = (lanes[j] < minimum) ? lanes[j] : minimum;
+		}
+	#elif defined(__SSE4_1__)
+		__m128i minimum4 = _mm_set1_epi32(INT_MAX);
+		for (; i + 4 <= count; i += 4)
+		{
+			minimum4 = _mm_min_epi32(minimum4, _mm_loadu_si128((__m128i *) (keys + i)));
+		}
+		int lanes[4];
+		_mm_storeu_si128((__m128i *) lanes, minimum4);
+		for (int j = 0; j < 4; j++)
+		{
+			minimum = (lanes[j] < minimum) ? lanes[j] : minimum;
+		}
+	#endif
+	for (; i < count; i++)
+	{
+		minimum = (keys[i] < minimum) ? keys[i] : minimum;
+	}
+	return minimum;
+}
+
+// returns the smallest process index among the processes having the given key
+int minSlotWithKey(int *keys, int *slots, int count, int key)
+{
+	int i = 0;
+	int minimum = INT_MAX;
+	#if defined(__AVX2__)
+		__m256i key8 = _mm256_set1_epi32(key);
+		__m256i minimum8 = _mm256_set1_epi32(INT_MAX);
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256((__m256i *) (keys + i)), key8);
+			__m256i candidates = _mm256_blendv_epi8(_mm256_set1_epi32(INT_MAX), _mm256_loadu_si256((__m256i *) (slots + i)), equal);
+			minimum8 = _mm256_min_epi32(minimum8, candidates);
+		}
+		int lanes[8];
+		_mm256_storeu_si256((__m256i *) lanes, minimum8);
+		for (int j = 0; j < 8; j++)
+		{
+			minimum = (lanes[j] < minimum) ? lanes[j] : minimum;
+		}
+	#elif defined(__SSE4_1__)
+		__m128i key4 = _mm_set1_epi32(key);
+		__m128i minimum4 = _mm_set1_epi32(INT_MAX);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i *) (keys + i)), key4);
+			__m128i candidates = _mm_blendv_epi8(_mm_set1_epi32(INT_MAX), _mm_loadu_si128((__m128i *) (slots + i)), equal);
+			minimum4 = _mm_min_epi32(minimum4, candidates);
+		}
+		int lanes[4];
+		_mm_storeu_si128((__m128i *) lanes, minimum4);
+		for (int j = 0; j < 4; j++)
+		{
+			minimum = (lanes[j] < minimum) ? lanes[j] : minimum;
+		}
+	#endif
+	for (; i < count; i++)
+	{
+		if ((keys[i] == key) && (slots[i] < minimum))
+		{
+			minimum = slots[i];
+		}
+	}
+	return minimum;
+}
+
+// returns true if the process at processIndex comes before the head of the queue
+bool beforeHead(struct readyQueue *p_readyQueue, struct arrayQueue *p_queue, int processIndex)
+{
+	if (p_readyQueue->head == -1)
+	{
+		return true;
+	}
+	int key = p_queue->keys[p_queue->position[processIndex]];
+	int headKey = p_queue->keys[p_queue->position[p_readyQueue->head]];
+	return (key < headKey) || ((key == headKey) && (processIndex < p_readyQueue->head));
+}
+
+void enqueue(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process *p_process, int processIndex, int schedulerType)
+{
+	HOT_PATH_TIMER(ENQUEUE_OPERATION);
+	struct arrayQueue queue = getArrayQueue(p_readyQueue, p_processBufferStart);
+	p_readyQueue->schedulerType = schedulerType;
+	
+	// append process to the array
+	int position = p_readyQueue->count;
+	switch (schedulerType)
+	{
+		case HPF:
+			queue.keys[position] = p_process->priority;
+			break;
+		case SRTN:
+			queue.keys[position] = p_process->remainingTime;
+			break;
+		case RR:
+			// renumber the queued keys from 0 before the enqueue order overflows, the order of the
+			// queued processes is kept since all their keys are shifted by the same amount
+			if (p_readyQueue->sequence == INT_MAX)
+			{
+				int minimum = (position == 0) ? p_readyQueue->sequence : minKey(queue.keys, position);
+				for (int i = 0; i < position; i++)
+				{
+					queue.keys[i] -= minimum;
+				}
+				p_readyQueue->sequence -= minimum;
+			}
+			queue.keys[position] = p_readyQueue->sequence++;
+			break;
+	}
+	queue.slots[position] = processIndex;
+	queue.position[processIndex] = position;
+	p_readyQueue->count++;
+	
+	// update head
+	HOT_PATH_WORK(ENQUEUE_OPERATION, 1);
+	if (beforeHead(p_readyQueue, &queue, processIndex))
+	{
+		p_readyQueue->head = processIndex;
+	}
+}
+
+void dequeue(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process *p_process)
+{
+	HOT_PATH_TIMER(DEQUEUE_OPERATION);
+	struct arrayQueue queue = getArrayQueue(p_readyQueue, p_processBufferStart);
+	int processIndex = p_process - p_processBufferStart;
+	
+	// move the last process of the array to the removed position
+	int position = queue.position[processIndex];
+	int last = --p_readyQueue->count;
+	queue.keys[position] = queue.keys[last];
+	queue.slots[position] = queue.slots[last];
+	queue.position[queue.slots[position]] = position;
+	
+	// corner case: queue is empty
+	if (p_readyQueue->count == 0)
+	{
+		p_readyQueue->head = -1;
+		return;
+	}
+	
+	// select new head
+	if (p_readyQueue->head == processIndex)
+	{
+		int key = minKey(queue.keys, p_readyQueue->count);
+		p_readyQueue->head = minSlotWithKey(queue.keys, queue.slots, p_readyQueue->count, key);
+	}
+}
+
+void decrementRemainingTime(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process *p_process)
+{
+	p_process->remainingTime--;
+	if (p_readyQueue->schedulerType != SRTN)
+	{
+		return;
+	}
+	
+	// update key if process is queued, the head is kept as in the linked ready queue
+	struct arrayQueue queue = getArrayQueue(p_readyQueue, p_processBufferStart);
+	int processIndex = p_process - p_processBufferStart;
+	int position = queue.position[processIndex];
+	if ((position < p_readyQueue->count) && (queue.slots[position] == processIndex))
+	{
+		queue.keys[position] = p_process->remainingTime;
+	}
+}
+
+// returns the index of the process after processIndex in the ready queue (the process with the next
+// smallest key, ties are broken by process index), -1 if it is the last one
+int nextInReadyQueue(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, int processIndex)
+{
+	struct arrayQueue queue = getArrayQueue(p_readyQueue, p_processBufferStart);
+	int key = queue.keys[queue.position[processIndex]];
+	int nextIndex = -1;
+	int nextKey = INT_MAX;
+	for (int i = 0; i < p_readyQueue->count; i++)
+	{
+		bool after = (queue.keys[i] > key) || ((queue.keys[i] == key) && (queue.slots[i] > processIndex));
+		bool before = (nextIndex == -1) || (queue.keys[i] < nextKey) || ((queue.keys[i] == nextKey) && (queue.slots[i] < nextIndex));
+		if (after && before)
+		{
+			nextIndex = queue.slots[i];
+			nextKey = queue.keys[i];
+		}
+	}
+	return nextIndex;
+}
+#else
+
 void enqueue(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process *p_process, int processIndex, int schedulerType)
-{	
+{
+	HOT_PATH_TIMER(ENQUEUE_OPERATION);	
 	// corner case: empty queue
 	if (p_readyQueue->head == -1)
 	{
@@ -115,9 +568,11 @@ void enqueue(struct readyQueue *p_readyQueue, struct process *p_processBufferSta
 	{
 		case HPF:
 			// corner case: process has highest priority
+			HOT_PATH_WORK(ENQUEUE_OPERATION, 1);
 			if (p_process->priority < p_currentProcess->priority)
 			{
 				p_process->next = p_readyQueue->head;
+				p_process->prev = -1;
 				p_currentProcess->prev = processIndex;
 				p_readyQueue->head = processIndex;
 				return;
@@ -126,6 +581,7 @@ void enqueue(struct readyQueue *p_readyQueue, struct process *p_processBufferSta
 			while (p_currentProcess->next != -1)
 			{
 				p_nextProcess = p_processBufferStart + p_currentProcess->next;
+				HOT_PATH_WORK(ENQUEUE_OPERATION, 1);
 				if (p_process->priority < p_nextProcess->priority)
 				{
 					p_process->next = p_currentProcess->next;
@@ -140,14 +596,17 @@ void enqueue(struct readyQueue *p_readyQueue, struct process *p_processBufferSta
 			// corner case: process has lowest priority
 			p_currentProcess->next = processIndex;
 			p_process->prev = p_readyQueue->tail;
+			p_process->next = -1;
 			p_readyQueue->tail = processIndex;
 			return;
 		
 		case SRTN:
 			// corner case: process has lowest remaining time
+			HOT_PATH_WORK(ENQUEUE_OPERATION, 1);
 			if (p_process->remainingTime < p_currentProcess->remainingTime)
 			{
 				p_process->next = p_readyQueue->head;
+				p_process->prev = -1;
 				p_currentProcess->prev = processIndex;
 				p_readyQueue->head = processIndex;
 				return;
@@ -156,6 +615,7 @@ void enqueue(struct readyQueue *p_readyQueue, struct process *p_processBufferSta
 			while (p_currentProcess->next != -1)
 			{
 				p_nextProcess = p_processBufferStart + p_currentProcess->next;
+				HOT_PATH_WORK(ENQUEUE_OPERATION, 1);
 				if (p_process->remainingTime < p_nextProcess->remainingTime)
 				{
 					p_process->next = p_currentProcess->next;
@@ -170,6 +630,7 @@ void enqueue(struct readyQueue *p_readyQueue, struct process *p_processBufferSta
 			// corner case: process has highest remaining time
 			p_currentProcess->next = processIndex;
 			p_process->prev = p_readyQueue->tail;
+			p_process->next = -1;
 			p_readyQueue->tail = processIndex;
 			return;
 			
@@ -186,6 +647,7 @@ void enqueue(struct readyQueue *p_readyQueue, struct process *p_processBufferSta
 
 void dequeue(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process *p_process)
 {
+	HOT_PATH_TIMER(DEQUEUE_OPERATION);
 	struct process *p_nextProcess = NULL;
 	struct process *p_prevProcess = NULL;
 
@@ -218,8 +680,123 @@ void dequeue(struct readyQueue *p_readyQueue, struct process *p_processBufferSta
 	return;
 }
 
-bool allocate(struct memUnit *memory, struct process *p_process)
+void decrementRemainingTime(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process *p_process)
+{
+	(void) p_readyQueue;
+	(void) p_processBufferStart;
+	p_process->remainingTime--;
+}
+
+// returns the index of the process after processIndex in the ready queue, -1 if it is the last one
+int nextInReadyQueue(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, int processIndex)
 {
+	(void) p_readyQueue;
+	return p_processBufferStart[processIndex].next;
+}
+#endif
+
+// Fixed-size object pool. Free objects are linked through their first bytes, so objects
+// must be at least as large as a pointer. When the pool is exhausted (or was never
+// initialized) objects are taken from malloc and counted.
+struct pool
+{
+	void *buffer;
+	void *freeList;
+	int allocations;
+	int mallocs;
+	size_t objectSize;
+};
+
+struct pool waitingProcessPool = {NULL, NULL, 0, 0, sizeof(struct waitingProcess)};
+struct pool memUnitPool = {NULL, NULL, 0, 0, sizeof(struct memUnit)};
+
+// memory counters maintained by the allocator
+struct memoryCounters
+{
+	int allocatedBytes;	// sum of allocation sizes of allocated processes
+	int requestedBytes;	// sum of memory sizes of allocated processes
+	int allocatedProcesses;
+};
+
+struct memoryCounters memoryCounters = {0, 0, 0};
+
+// allocator selected at startup
+int allocatorType = BUDDY;
+
+void countAllocation(struct process *p_process, int sign)
+{
+	memoryCounters.allocatedBytes += sign * p_process->allocationSize;
+	memoryCounters.requestedBytes += sign * p_process->memSize;
+	memoryCounters.allocatedProcesses += sign;
+}
+
+void initPool(struct pool *p_pool, int capacity)
+{
+	p_pool->buffer = malloc(capacity * p_pool->objectSize);
+	p_pool->freeList = NULL;
+	p_pool->allocations = 0;
+	p_pool->mallocs = 0;
+	for (int i = capacity - 1; i >= 0; i--)
+	{
+		void *p_object = (char *) p_pool->buffer + (i * p_pool->objectSize);
+		*(void **) p_object = p_pool->freeList;
+		p_pool->freeList = p_object;
+	}
+}
+
+void *poolAllocate(struct pool *p_pool)
+{
+	p_pool->allocations++;
+	
+	// corner case: pool is exhausted
+	if (p_pool->freeList == NULL)
+	{
+		p_pool->mallocs++;
+		return malloc(p_pool->objectSize);
+	}
+	
+	void *p_object = p_pool->freeList;
+	p_pool->freeList = *(void **) p_object;
+	return p_object;
+}
+
+void poolFree(struct pool *p_pool, void *p_object)
+{
+	*(void **) p_object = p_pool->freeList;
+	p_pool->freeList = p_object;
+}
+
+void updateLargestFree(struct memUnit *p_memUnit)
+{
+	// recompute the largest free memory unit from the given unit up to the root
+	while (p_memUnit != NULL)
+	{
+		if ((p_memUnit->left == NULL) && (p_memUnit->right == NULL))
+		{
+			p_memUnit->largestFree = (p_memUnit->id == EMPTY) ? p_memUnit->size : 0;
+		}
+		else if (p_memUnit->left->largestFree > p_memUnit->right->largestFree)
+		{
+			p_memUnit->largestFree = p_memUnit->left->largestFree;
+		}
+		else
+		{
+			p_memUnit->largestFree = p_memUnit->right->largestFree;
+		}
+		p_memUnit = p_memUnit->parent;
+	}
+}
+
+bool buddyAllocate(struct memUnit *memory, struct process *p_process)
+{
+	HOT_PATH_WORK(ALLOCATE_OPERATION, 1);
+	
+	// no free memory unit in this subtree can hold the process
+	if (memory->largestFree < p_process->allocationSize)
+	{
+		return false;
+	}
+	
 	// base condition
 	if ((memory->left == NULL) && (memory->right == NULL))
 	{
@@ -232,6 +809,8 @@ bool allocate(struct memUnit *memory, struct process *p_process)
 		{
 			memory->id = p_process->id;
 			p_process->allocatedMemUnit = memory;
+			updateLargestFree(memory);
+			countAllocation(p_process, 1);
 			return true;
 		}
 		
@@ -260,37 +839,43 @@ bool allocate(struct memUnit *memory, struct process *p_process)
 	
 	//search in memory (left first then right)
 	
-	if (allocate(memory->left, p_process))
+	if (buddyAllocate(memory->left, p_process))
 	{
 		return true;
 	}
 	else 
 	{
-		return allocate(memory->right, p_process);
+		return buddyAllocate(memory->right, p_process);
 	}
 }
 
 void splitAllocate(struct process *p_process)
 {
+	HOT_PATH_TIMER(SPLIT_ALLOCATE_OPERATION);
+	
 	// get memory unit
 	struct memUnit *p_memUnit = p_process->allocatedMemUnit;
 	
 	while (p_memUnit->size != p_process->allocationSize)
 	{
+		HOT_PATH_WORK(SPLIT_ALLOCATE_OPERATION, 1);
+		
 		// create left memory unit
-		p_memUnit->left = (struct memUnit *) malloc(sizeof(struct memUnit));
+		p_memUnit->left = (struct memUnit *) poolAllocate(&memUnitPool);
 		p_memUnit->left->id = EMPTY;
 		p_memUnit->left->size = 0.5 * p_memUnit->size;
 		p_memUnit->left->start = p_memUnit->start;
+		p_memUnit->left->largestFree = p_memUnit->left->size;
 		p_memUnit->left->parent = p_memUnit;
 		p_memUnit->left->left = NULL;
 		p_memUnit->left->right = NULL;
 		
 		// create right memory unit
-		p_memUnit->right = (struct memUnit *) malloc(sizeof(struct memUnit));
+		p_memUnit->right = (struct memUnit *) poolAllocate(&memUnitPool);
 		p_memUnit->right->id = EMPTY;
 		p_memUnit->right->size = 0.5 * p_memUnit->size;
 		p_memUnit->right->start = p_memUnit->start + p_memUnit->right->size;
+		p_memUnit->right->largestFree = p_memUnit->right->size;
 		p_memUnit->right->parent = p_memUnit;
 		p_memUnit->right->left = NULL;
 		p_memUnit->right->right = NULL;
@@ -305,9 +890,11 @@ void splitAllocate(struct process *p_process)
 	// allocate process
 	p_memUnit->id = p_process->id;
 	p_process->allocatedMemUnit = p_memUnit;
+	updateLargestFree(p_memUnit);
+	countAllocation(p_process, 1);
 }
 
-void deallocate(struct process *p_process)
+void buddyDeallocate(struct process *p_process)
 {
 	// get memory unit
 	struct memUnit *p_memUnit = p_process->allocatedMemUnit;
@@ -315,6 +902,8 @@ void deallocate(struct process *p_process)
 	// deallocate memory unit
 	p_memUnit->id = EMPTY;
 	p_process->allocatedMemUnit = NULL;
+	countAllocation(p_process, -1);
+	struct memUnit *p_freedMemUnit = p_memUnit;
 	
 	while (p_memUnit->parent != NULL)
 	{
@@ -323,74 +912,127 @@ void deallocate(struct process *p_process)
 		
 		if ((p_memUnit->left->id == -1) && (p_memUnit->right->id == -1)) // merge
 		{
+			HOT_PATH_WORK(DEALLOCATE_OPERATION, 1);
+			
 			// mark parent as empty
 			p_memUnit->id = EMPTY;
+			p_freedMemUnit = p_memUnit;
 		
 			// delete left child
-			free(p_memUnit->left);
+			poolFree(&memUnitPool, p_memUnit->left);
 			p_memUnit->left = NULL;
 			
 			// delete right child
-			free(p_memUnit->right);
+			poolFree(&memUnitPool, p_memUnit->right);
 			p_memUnit->right = NULL;
 		}
 		else
 		{
-			return;
+			break;
 		}
 	}
+	updateLargestFree(p_freedMemUnit);
+}
+
+int allocationOrder(int allocationSize)
+{
+	int order = 0;
+	while (((SMALLEST_ALLOCATION_UNIT << order) < allocationSize) && (order < (ALLOCATION_ORDERS - 1)))
+	{
+		order++;
+	}
+	return order;
 }
 
 void addToWaitingList(struct waitingQueue *waitingList, struct process *p_process)
 {
-	struct waitingProcess *newWaitingProcess = (struct waitingProcess *) malloc(sizeof(struct waitingProcess));
+	struct waitingClass *p_class = &waitingList->classes[allocationOrder(p_process->allocationSize)];
+	struct waitingProcess *newWaitingProcess = (struct waitingProcess *) poolAllocate(&waitingProcessPool);
 	newWaitingProcess->p_process = p_process;
 	
-	// corner case: waiting list is empty
-	if (waitingList->head == NULL)
+	// renumber the waiting processes from 0 before the waiting order overflows, the order is kept
+	// since all of them are shifted by the oldest sequence, which is at the head of a class
+	if (waitingList->sequence == INT_MAX)
+	{
+		int minimum = waitingList->sequence;
+		for (int i = 0; i < ALLOCATION_ORDERS; i++)
+		{
+			if ((waitingList->classes[i].head != NULL) && (waitingList->classes[i].head->sequence < minimum))
+			{
+				minimum = waitingList->classes[i].head->sequence;
+			}
+		}
+		for (int i = 0; i < ALLOCATION_ORDERS; i++)
+		{
+			for (struct waitingProcess *p_waitingProcess = waitingList->classes[i].head; p_waitingProcess != NULL; p_waitingProcess = p_waitingProcess->next)
+			{
+				p_waitingProcess->sequence -= minimum;
+			}
+		}
+		waitingList->sequence -= minimum;
+	}
+	newWaitingProcess->sequence = waitingList->sequence++;
+	waitingList->count++;
+	
+	// corner case: class is empty
+	if (p_class->head == NULL)
 	{		
 		newWaitingProcess->prev = NULL;
 		newWaitingProcess->next = NULL;
-		waitingList->head = newWaitingProcess;
-		waitingList->tail = newWaitingProcess;
+		p_class->head = newWaitingProcess;
+		p_class->tail = newWaitingProcess;
 		return;
 	}
 	
-	// insert in the tail of the waiting list
-	waitingList->tail->next = newWaitingProcess;
-	newWaitingProcess->prev = waitingList->tail;
+	// insert in the tail of the class
+	p_class->tail->next = newWaitingProcess;
+	newWaitingProcess->prev = p_class->tail;
 	newWaitingProcess->next = NULL;
-	waitingList->tail = newWaitingProcess;
+	p_class->tail = newWaitingProcess;
 }
 
 void removeFromWaitingList(struct waitingQueue *waitingList, struct waitingProcess *p_waitingProcess)
 {
+	struct waitingClass *p_class = &waitingList->classes[allocationOrder(p_waitingProcess->p_process->allocationSize)];
 	struct waitingProcess *p_prevWaitingProcess = p_waitingProcess->prev;
 	struct waitingProcess *p_nextWaitingProcess = p_waitingProcess->next;
+	waitingList->count--;
 	
 	// corner case: remove head
 	if (p_prevWaitingProcess == NULL)
 	{
-		waitingList->head = p_nextWaitingProcess;
+		p_class->head = p_nextWaitingProcess;
 		if (p_nextWaitingProcess != NULL)
 		{
 			p_nextWaitingProcess->prev = NULL;
 		}
-		free(p_waitingProcess);
+		else
+		{
+			p_class->tail = NULL;
+		}
+		poolFree(&waitingProcessPool, p_waitingProcess);
 		return;
 	}
 	
 	// corner case: remove tail
 	if (p_nextWaitingProcess == NULL)
 	{
-		waitingList->tail = p_prevWaitingProcess;
+		p_class->tail = p_prevWaitingProcess;
 		p_prevWaitingProcess->next = NULL;
-		free(p_waitingProcess);
+		poolFree(&waitingProcessPool, p_waitingProcess);
 		return;
 	}
 	
 	// normal case:	
 	p_prevWaitingProcess->next = p_waitingProcess->next;
 	p_nextWaitingProcess->prev = p_waitingProcess->prev;
-	free(p_waitingProcess);
+	poolFree(&waitingProcessPool, p_waitingProcess);
 }
+
+#include "allocators.h"
+#ifdef BINARY_LOG
+#include "event_log.h"
+#endif
+#ifdef TRACE_EXPORT
+#include "trace_export.h"
+#endif
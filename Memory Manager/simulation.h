@@ -0,0 +1,1272 @@
+// Scheduler and memory manager of a simulation. The scheduler program (scheduler.c) steps the
+// simulation once per clock tick and runs every process as a forked process.out that shares its
+// PCB through shared memory. With IN_PROCESS the processes are not forked, their PCBs live in
+// plain memory and the engine (engine.h) runs them.
+
+#include "scheduler_utilities.h"
+#include <math.h>
+#include "performance_stats.h"
+#ifdef PAGING
+#include "paging.h"
+#endif
+#ifdef DYNAMIC_ALLOCATION
+#include "dynamic_allocation.h"
+#endif
+#ifdef BACKFILLING
+#include "backfill.h"
+#endif
+#ifdef SWAPPING
+#include "swap.h"
+#endif
+#ifdef COMPACTION
+#include "compaction.h"
+#endif
+#ifdef MEMORY_STATS
+#include "memory_stats.h"
+#endif
+#ifdef REAL_MEMORY
+#include "real_memory.h"
+#endif
+#ifdef LIVE_METRICS
+#include "live_metrics.h"
+#endif
+
+// definitions
+#define PROCESS "./process.out"
+
+// forward declarations
+void writeLog(FILE *pFile, int currentTime, struct PCB *p_scheduledPCB, int logType);
+void schedulerHPF(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process **p_scheduledProcess, struct PCB **p_scheduledPCB, int currentTime, int *processTable, int PCB_sem, int *processesFinished, FILE *pFile, struct memUnit *memory, FILE *pMemFile);
+void schedulerSRTN(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process **p_scheduledProcess, struct PCB **p_scheduledPCB, int currentTime, int *processTable, int PCB_sem, int *processesFinished, FILE *pFile, struct memUnit *memory, FILE *pMemFile, struct waitingQueue *waitingList);
+void schedulerRR(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process **p_scheduledProcess, struct PCB **p_scheduledPCB, int currentTime, int *processTable, int PCB_sem, int *processesFinished, int quantum, int *processQuantum, FILE *pFile, struct memUnit *memory, FILE *pMemFile, struct waitingQueue *waitingList);
+void writeMemLog(FILE *pFile, int currentTime, struct process* p_process, int logType);
+bool tryAllocate(FILE *pFile, int currentTime, struct memUnit *memory, struct process *p_process);
+bool scheduleFromWaitingList(struct waitingQueue *waitingList, struct process **p_scheduledProcess, FILE *pFile, int currentTime, struct memUnit *memory);
+void scheduleFromReadyQueue(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct waitingQueue *waitingList, struct process **p_scheduledProcess, FILE *pFile, int currentTime, struct memUnit *memory);
+struct process *scheduleFromReadyQueueHPF(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, FILE *pFile, int currentTime, struct memUnit *memory);
+struct PCB *dispatchProcess(FILE *pFile, int *processTable, int PCB_sem, struct process *p_process, int currentTime);
+
+// global variables
+int PCB_sem;
+struct memUnit *memory;
+
+// Simulation state. The scheduler steps the simulation once per clock tick after the generator
+// enqueued the processes that arrived at that tick. The in-process engine (engine.h) steps the
+// same simulation without the clock and the semaphores.
+struct simulation
+{
+	struct schedulerInfo *p_schedulerInfo;
+	struct readyQueue *p_readyQueue;
+	struct process *p_processBufferStart;
+	int N;	// total number of processes in simulation
+	int *processTable;
+	struct waitingQueue waitingList;
+	FILE *pFile;
+	FILE *pMemFile;
+	#ifdef PAGING
+		FILE *pPagingFile;
+	#endif
+	#ifdef REAL_MEMORY
+		int realMemoryFd;
+		struct realMemoryStats *p_realMemory;
+	#endif
+	#if defined(TRACE_EXPORT) || defined(LIVE_METRICS)
+		int arrivedProcesses;
+	#endif
+	int currentTime;
+	int wastedTime;
+	int processesFinished;
+	int processQuantum;
+	struct process *p_scheduledProcess;
+	struct PCB *p_scheduledPCB;
+};
+
+struct simulation simulation;
+
+#ifdef IN_PROCESS
+// PCBs of the processes run by the engine, indexed by the process table
+struct PCB *PCBTable;
+#endif
+
+// creates the process with the given id and returns its uninitialized PCB
+struct PCB *createPCB(int *processTable, int id)
+{
+	#ifdef IN_PROCESS
+		processTable[id - 1] = id - 1;
+		return &PCBTable[id - 1];
+	#else
+		// start process and store its pid in the process table
+		processTable[id - 1] = createProcess(PROCESS);
+
+		// create PCB to be share with the process
+		int PCB_shmid = shmget(processTable[id - 1], sizeof(struct PCB), IPC_CREAT | 0644);
+		return shmat(PCB_shmid, (void *)0, 0);
+	#endif
+}
+
+// starts a process that is scheduled for the first time and returns its initialized PCB
+struct PCB *startProcess(int *processTable, int PCB_sem, struct process *p_process, int currentTime)
+{
+	HOT_PATH_TIMER(PROCESS_CREATION_OPERATION);
+	struct PCB *p_PCB = createPCB(processTable, p_process->id);
+
+	// initialize PCB
+	p_PCB->id = p_process->id;
+	p_PCB->state = RUNNING;
+	p_PCB->arrivalTime = p_process->arrivalTime;
+	p_PCB->executionTime = p_process->runningTime;
+	p_PCB->remainingTime = p_process->remainingTime;
+	p_PCB->waitingTime = (currentTime - p_PCB->arrivalTime) - (p_PCB->executionTime - p_PCB->remainingTime);
+	p_PCB->priority = p_process->priority;
+
+	#ifdef IN_PROCESS
+		(void) PCB_sem;
+	#else
+		// enable process to read PCB
+		up(PCB_sem);
+	#endif
+	return p_PCB;
+}
+
+// returns the PCB of a started process
+struct PCB *selectPCB(int *processTable, struct process *p_process)
+{
+	#ifdef IN_PROCESS
+		return &PCBTable[processTable[p_process->id - 1]];
+	#else
+		int PCB_shmid = shmget(processTable[p_process->id - 1], sizeof(struct PCB), IPC_CREAT | 0644);
+		return shmat(PCB_shmid, (void *)0, 0);
+	#endif
+}
+
+void deletePCB(int *processTable, struct PCB *p_PCB)
+{
+	#ifdef IN_PROCESS
+		(void) processTable;
+		(void) p_PCB;
+	#else
+		int PCB_shmid = shmget(processTable[p_PCB->id - 1], sizeof(struct PCB), IPC_CREAT | 0644);
+		shmctl(PCB_shmid, IPC_RMID, (struct shmid_ds *) 0);
+	#endif
+}
+
+#ifdef CHECKPOINT
+#include "checkpoint.h"
+#endif
+
+// opens a log and writes its header, or continues the log of the checkpoint being resumed
+FILE *openLog(char *name, char *header)
+{
+	#ifdef CHECKPOINT
+		long length = resumeLogLength(name);
+		if (length != -1)
+		{
+			// drop what was logged after the checkpoint
+			FILE *pFile = fopen(instancePath(name), "r+");
+			if ((pFile != NULL) && (ftruncate(fileno(pFile), length) == 0) && (fseek(pFile, length, SEEK_SET) == 0))
+			{
+				return pFile;
+			}
+			printf("Could not continue %s, starting it over\n", instancePath(name));
+			if (pFile != NULL)
+			{
+				fclose(pFile);
+			}
+		}
+	#endif
+	FILE *pFile = fopen(instancePath(name), "w");
+	fprintf(pFile, "%s", header);
+	return pFile;
+}
+
+void initSimulation(struct schedulerInfo *p_schedulerInfo, struct readyQueue *p_readyQueue, struct process *p_processBufferStart, int N, int currentTime)
+{
+	simulation.p_schedulerInfo = p_schedulerInfo;
+	simulation.p_readyQueue = p_readyQueue;
+	simulation.p_processBufferStart = p_processBufferStart;
+	simulation.N = N;
+
+	// The process table contains the pid of each process. The pid in the process table is used as an
+	// id to get the address of the shared memory where the PCB of the corresponding process is stored.
+	// The process table is initialized with -1 and overwritten during forking.
+	simulation.processTable = (int *) malloc(N * sizeof(int));
+	for (int i = 0; i < N; i++)
+	{
+		simulation.processTable[i] = -1;
+	}
+	#ifdef IN_PROCESS
+		PCBTable = (struct PCB *) calloc(N, sizeof(struct PCB));
+	#endif
+	
+	// performance statistics
+	initPerformanceStats();
+	#ifdef HOT_PATH_STATS
+		initHotPathStats();
+	#endif
+	
+	// waiting list
+	for (int i = 0; i < ALLOCATION_ORDERS; i++)
+	{
+		simulation.waitingList.classes[i].head = NULL;
+		simulation.waitingList.classes[i].tail = NULL;
+	}
+	simulation.waitingList.count = 0;
+	simulation.waitingList.sequence = 0;
+	
+	// preallocate waiting list nodes and memory units
+	initPool(&waitingProcessPool, N);
+	initPool(&memUnitPool, MEMORY_UNITS);
+	
+	// memory
+	memory = (struct memUnit *) poolAllocate(&memUnitPool);
+	memory->id = -1;
+	memory->size = MEMORY_SIZE;
+	memory->start = 0;
+	memory->largestFree = MEMORY_SIZE;
+	memory->parent = NULL;
+	memory->left = NULL;
+	memory->right = NULL;
+	allocatorType = p_schedulerInfo->allocatorType;
+	initAllocator(memory);
+		
+	#ifdef BINARY_LOG
+		// scheduler.log and memory.log are decoded from the event log
+		simulation.pFile = NULL;
+		simulation.pMemFile = NULL;
+		initEventLog();
+	#else
+		// open scheduler.log
+		simulation.pFile = openLog(LOG, "# At time x process y state arr w total z remain y wait k\n");
+		
+		// open memory.log
+		simulation.pMemFile = openLog(MEMORY, "# At time x allocated y bytes for process z from i to j\n");
+	#endif
+	
+	#ifdef PAGING
+		// open paging.log
+		simulation.pPagingFile = fopen(instancePath(PAGING_LOG), "w");
+		fprintf(simulation.pPagingFile, "# At time x process y page fault on page p loaded in frame f\n");
+		initPaging(N, simulation.pPagingFile);
+	#endif
+	
+	#ifdef BACKFILLING
+		initBackfill(N, p_processBufferStart, p_schedulerInfo->schedulerType);
+	#endif
+	
+	#ifdef SWAPPING
+		// open swap file
+		initSwap(N);
+	#endif
+	
+	#ifdef COMPACTION
+		initCompaction(N, p_processBufferStart);
+	#endif
+	
+	#ifdef MEMORY_STATS
+		// open memory.csv
+		initMemoryStats();
+	#endif
+	
+	#ifdef REAL_MEMORY
+		// create the real memory backing shared with the processes
+		simulation.realMemoryFd = createRealMemory();
+		simulation.p_realMemory = mapRealMemory(simulation.realMemoryFd);
+	#endif
+	
+	#ifdef DYNAMIC_ALLOCATION
+		initDynamicAllocation(N);
+		#ifdef BACKFILLING
+			// the backfill reservation keeps the units covered by the blocks
+			dynamicAllocation.blockChanged = coverBackfillBlock;
+		#endif
+	#endif
+	
+	#ifdef TRACE_EXPORT
+		// open trace.json
+		initTrace();
+	#endif
+	
+	#ifdef LIVE_METRICS
+		// create the shared metrics block
+		initLiveMetrics(N);
+	#endif
+	
+	#ifdef CHECKPOINT
+		initCheckpoints(N);
+	#endif
+	
+	#if defined(TRACE_EXPORT) || defined(LIVE_METRICS)
+		simulation.arrivedProcesses = 0;
+	#endif
+	
+	simulation.wastedTime = 0;
+	simulation.processesFinished = 0;
+	simulation.processQuantum = 0;
+	simulation.p_scheduledProcess = NULL;
+	simulation.p_scheduledPCB = NULL;
+	simulation.currentTime = currentTime;
+	
+	#ifdef CHECKPOINT
+		// continue from the checkpoint named by OSSIM_RESUME
+		resumeSimulation();
+	#endif
+}
+
+// runs the scheduling algorithm for the current time step
+void runScheduler()
+{
+	switch (simulation.p_schedulerInfo->schedulerType)
+	{
+		case HPF:
+			schedulerHPF(simulation.p_readyQueue, simulation.p_processBufferStart, &simulation.p_scheduledProcess, &simulation.p_scheduledPCB, simulation.currentTime, simulation.processTable, PCB_sem, &simulation.processesFinished, simulation.pFile, memory, simulation.pMemFile);
+			break;
+		
+		case SRTN:
+			schedulerSRTN(simulation.p_readyQueue, simulation.p_processBufferStart, &simulation.p_scheduledProcess, &simulation.p_scheduledPCB, simulation.currentTime, simulation.processTable, PCB_sem, &simulation.processesFinished, simulation.pFile, memory, simulation.pMemFile, &simulation.waitingList);
+			break;
+		case RR:
+			schedulerRR(simulation.p_readyQueue, simulation.p_processBufferStart, &simulation.p_scheduledProcess, &simulation.p_scheduledPCB, simulation.currentTime, simulation.processTable, PCB_sem, &simulation.processesFinished, simulation.p_schedulerInfo->quantum, &simulation.processQuantum, simulation.pFile, memory, simulation.pMemFile, &simulation.waitingList);
+			break;
+	}
+}
+
+#ifdef DYNAMIC_ALLOCATION
+// takes a process that blocked on an allocation request off the CPU and out of the ready queue
+// until the request is met, and schedules the next process in its place
+void blockProcess(struct process *p_process)
+{
+	// the ready queue holds the running process in HPF and SRTN, and the preempted processes
+	if ((simulation.p_schedulerInfo->schedulerType != RR) || (p_process != simulation.p_scheduledProcess))
+	{
+		dequeue(simulation.p_readyQueue, simulation.p_processBufferStart, p_process);
+	}
+	if (p_process == simulation.p_scheduledProcess)
+	{
+		simulation.p_scheduledPCB->state = WAITING;
+		#ifdef PRINTING
+			printf("Scheduler: Process %d is blocked\n", p_process->id);
+		#endif
+		writeLog(simulation.pFile, simulation.currentTime, simulation.p_scheduledPCB, STOPPED);
+		simulation.p_scheduledProcess = NULL;
+		simulation.processQuantum = 0;
+		runScheduler();
+	}
+}
+#endif
+
+// schedules the current time step, after the generator enqueued the processes that arrived
+void stepSimulation()
+{
+	#ifdef PAGING
+		// simulate the memory accesses of the process that ran during the last time step
+		struct process *p_ranProcess = simulation.p_scheduledProcess;
+		if (p_ranProcess != NULL)
+		{
+			simulateAccesses(simulation.currentTime, simulation.p_processBufferStart, p_ranProcess);
+		}
+	#endif
+	
+	#ifdef DYNAMIC_ALLOCATION
+		// service the allocation requests submitted during the last time step, the processes whose
+		// requests are met are enqueued again
+		struct process *p_requestingProcess = simulation.p_scheduledProcess;
+		serviceAllocationRequests(simulation.pMemFile, simulation.currentTime, memory, (p_requestingProcess != NULL) ? simulation.p_scheduledPCB : NULL, simulation.p_readyQueue, simulation.p_processBufferStart, simulation.p_schedulerInfo->schedulerType);
+	#endif
+	
+	runScheduler();
+	
+	#ifdef PAGING
+		// release the pages of a finished process
+		if ((p_ranProcess != NULL) && (p_ranProcess->remainingTime <= 0))
+		{
+			releasePages(simulation.p_processBufferStart, p_ranProcess);
+		}
+	#endif
+	
+	#ifdef DYNAMIC_ALLOCATION
+		// free the blocks of a finished process
+		if ((p_requestingProcess != NULL) && (p_requestingProcess->remainingTime <= 0))
+		{
+			releaseBlocks(simulation.pMemFile, simulation.currentTime, p_requestingProcess);
+		}
+		else if ((p_requestingProcess != NULL) && dynamicAllocation.blocked[p_requestingProcess->id - 1])
+		{
+			blockProcess(p_requestingProcess);
+		}
+		
+		// the blocked processes hold the memory, so no process can run and free memory for them
+		while ((simulation.p_scheduledProcess == NULL) && (dynamicAllocation.blockedCount > 0))
+		{
+			denyBlockedRequests(simulation.pMemFile, simulation.currentTime, memory, simulation.p_readyQueue, simulation.p_processBufferStart, simulation.p_schedulerInfo->schedulerType);
+			runScheduler();
+		}
+		
+		// give the running process its request rate and size
+		if (simulation.p_scheduledProcess != NULL)
+		{
+			simulation.p_scheduledPCB->requestRate = simulation.p_scheduledProcess->requestRate;
+			simulation.p_scheduledPCB->requestSize = simulation.p_scheduledProcess->requestSize;
+		}
+	#endif
+	
+	#ifdef REAL_MEMORY
+		// give the running process its current range of the real memory
+		if ((simulation.p_scheduledProcess != NULL) && (simulation.p_scheduledProcess->allocatedMemUnit != NULL))
+		{
+			simulation.p_scheduledPCB->memoryFd = simulation.realMemoryFd;
+			simulation.p_scheduledPCB->memoryStart = simulation.p_scheduledProcess->allocatedMemUnit->start;
+			simulation.p_scheduledPCB->memorySize = simulation.p_scheduledProcess->allocationSize;
+		}
+	#endif
+	
+	#ifdef MEMORY_STATS
+		sampleMemory(simulation.currentTime, memory, &simulation.waitingList);
+	#endif
+	
+	#if defined(TRACE_EXPORT) || defined(LIVE_METRICS)
+		// the generator fills the process buffer in arrival order, and the processes that arrived
+		// and are not finished, waiting for memory or running are ready
+		while ((simulation.arrivedProcesses < simulation.N) && (simulation.p_processBufferStart[simulation.arrivedProcesses].id != 0))
+		{
+			simulation.arrivedProcesses++;
+		}
+		int readyProcesses = simulation.arrivedProcesses - simulation.processesFinished - simulation.waitingList.count - ((simulation.p_scheduledProcess != NULL) ? 1 : 0);
+		#ifdef DYNAMIC_ALLOCATION
+			readyProcesses -= dynamicAllocation.blockedCount;
+		#endif
+	#endif
+	
+	#ifdef TRACE_EXPORT
+		traceCounters(simulation.currentTime, readyProcesses, simulation.waitingList.count, MEMORY_SIZE - memoryCounters.allocatedBytes);
+	#endif
+	
+	#ifdef LIVE_METRICS
+		publishMetrics(simulation.currentTime, simulation.p_scheduledProcess, readyProcesses, simulation.waitingList.count, simulation.processesFinished, simulation.wastedTime, memory);
+	#endif
+}
+
+// moves the simulation to the next time step, counting the time steps the CPU was idle
+void advanceSimulation(int currentTime)
+{
+	if (simulation.processesFinished != simulation.N)
+	{
+		simulation.currentTime = currentTime;
+		if (simulation.p_scheduledProcess == NULL)
+		{
+			simulation.wastedTime++;
+		}
+	}
+}
+
+// closes the logs and writes the performance log
+void finishSimulation()
+{
+	#ifdef PRINTING
+		printf("\033[0;32m"); // set color to green
+		printf("===================\n");
+		printf("SIMULATION FINISHED\n");
+		printf("===================\n");
+		printf("\033[0;37m"); // set color to white
+	#endif	
+	
+	// close log files
+	#ifdef BINARY_LOG
+		closeEventLog();
+	#else
+		fclose(simulation.pFile);
+		fclose(simulation.pMemFile);
+	#endif
+	#ifdef PAGING
+		fclose(simulation.pPagingFile);
+	#endif
+	#ifdef MEMORY_STATS
+		fclose(memoryStats.pFile);
+	#endif
+	#ifdef TRACE_EXPORT
+		closeTrace();
+	#endif
+	#ifdef LIVE_METRICS
+		finishLiveMetrics();
+	#endif
+	
+	// performance log
+	int currentTime = simulation.currentTime;
+	FILE *pFile = fopen(instancePath(PERFORMANCE), "w");
+	fprintf(pFile, "CPU utilization = %.2f%%\n", ((currentTime - simulation.wastedTime) / (float) currentTime) * 100); // CPU utilization
+	fprintf(pFile, "Avg WTA = %.2f\n", performance.weightedTurnaround.mean); // average weighted turnaround time
+	fprintf(pFile, "Avg Waiting = %.2f\n", performance.waiting.mean); // average waiting time
+	fprintf(pFile, "Std WTA = %.2f\n", standardDeviation(&performance.weightedTurnaround));
+	writeStreamingStats(pFile, "WTA", &performance.weightedTurnaround);
+	writeStreamingStats(pFile, "Waiting", &performance.waiting);
+	writeStreamingStats(pFile, "Response", &performance.response);
+	writeStreamingStats(pFile, "Turnaround", &performance.turnaround);
+	fprintf(pFile, "Waiting list nodes: %d allocations, %d mallocs\n", waitingProcessPool.allocations, waitingProcessPool.mallocs);
+	fprintf(pFile, "Memory units: %d allocations, %d mallocs\n", memUnitPool.allocations, memUnitPool.mallocs);
+	#ifdef PAGING
+		writePagingPerformance(pFile, simulation.N);
+	#endif
+	#ifdef BACKFILLING
+		writeBackfillPerformance(pFile);
+	#endif
+	#ifdef SWAPPING
+		writeSwapPerformance(pFile);
+	#endif
+	#ifdef COMPACTION
+		writeCompactionPerformance(pFile);
+	#endif
+	#ifdef MEMORY_STATS
+		writeMemoryStatsPerformance(pFile);
+	#endif
+	#ifdef REAL_MEMORY
+		writeRealMemoryPerformance(pFile, simulation.p_realMemory);
+	#endif
+	#ifdef DYNAMIC_ALLOCATION
+		writeDynamicAllocationPerformance(pFile);
+	#endif
+	#ifdef BINARY_LOG
+		writeEventLogPerformance(pFile);
+	#endif
+	#ifdef TRACE_EXPORT
+		writeTracePerformance(pFile);
+	#endif
+	#ifdef HOT_PATH_STATS
+		#ifndef IN_PROCESS
+			mergeHotPathStats(&simulation.p_schedulerInfo->generatorHotPath);
+		#endif
+		writeHotPathPerformance(pFile);
+	#endif
+	#ifdef CHECKPOINT
+		writeCheckpointPerformance(pFile);
+	#endif
+	fclose(pFile);
+}
+
+// frees dynamically allocated memory
+void destroySimulation()
+{
+	free(simulation.processTable);
+	simulation.processTable = NULL;
+	#ifdef IN_PROCESS
+		free(PCBTable);
+		PCBTable = NULL;
+	#endif
+	free(waitingProcessPool.buffer);
+	waitingProcessPool.buffer = NULL;
+	free(memUnitPool.buffer);
+	memUnitPool.buffer = NULL;
+	#ifdef SWAPPING
+		destroySwap();
+	#endif
+	#ifdef LIVE_METRICS
+		destroyLiveMetrics();
+	#endif
+	#ifdef CHECKPOINT
+		destroyCheckpoints();
+	#endif
+}
+
+void writeLog(FILE *pFile, int currentTime, struct PCB *p_scheduledPCB, int logType)
+{
+	HOT_PATH_TIMER(LOG_WRITE_OPERATION);
+	recordPerformance(currentTime, p_scheduledPCB, logType);
+	#ifdef TRACE_EXPORT
+		traceProcess(currentTime, p_scheduledPCB, logType);
+	#endif
+	#ifdef BINARY_LOG
+		logEvent(logType, currentTime, p_scheduledPCB->id, p_scheduledPCB->arrivalTime, p_scheduledPCB->executionTime, p_scheduledPCB->remainingTime, p_scheduledPCB->waitingTime, 0);
+		return;
+	#endif
+	switch (logType)
+	{
+		case STARTED:
+			fprintf(pFile, "At time %d ", currentTime);
+			fprintf(pFile, "process %d started ", p_scheduledPCB->id);
+			fprintf(pFile, "arr %d ", p_scheduledPCB->arrivalTime);
+			fprintf(pFile, "total %d ", p_scheduledPCB->executionTime);
+			fprintf(pFile, "remain %d ", p_scheduledPCB->remainingTime);
+			fprintf(pFile, "wait %d\n", p_scheduledPCB->waitingTime);
+			return;
+		
+		case STOPPED:
+			fprintf(pFile, "At time %d ", currentTime);
+			fprintf(pFile, "process %d stopped ", p_scheduledPCB->id);
+			fprintf(pFile, "arr %d ", p_scheduledPCB->arrivalTime);
+			fprintf(pFile, "total %d ", p_scheduledPCB->executionTime);
+			fprintf(pFile, "remain %d ", p_scheduledPCB->remainingTime);
+			fprintf(pFile, "wait %d\n", p_scheduledPCB->waitingTime);
+			return;
+		
+		case FINISHED:
+			fprintf(pFile, "At time %d ", currentTime);
+			fprintf(pFile, "process %d finished ", p_scheduledPCB->id);
+			fprintf(pFile, "arr %d ", p_scheduledPCB->arrivalTime);
+			fprintf(pFile, "total %d ", p_scheduledPCB->executionTime);
+			fprintf(pFile, "remain %d ", p_scheduledPCB->remainingTime);
+			fprintf(pFile, "wait %d ", p_scheduledPCB->waitingTime);
+			fprintf(pFile, "TA %d ", (currentTime - p_scheduledPCB->arrivalTime));
+			fprintf(pFile, "WTA %.2f\n", ((currentTime - p_scheduledPCB->arrivalTime) / (float) p_scheduledPCB->executionTime));
+			return;
+		
+		case RESUMED:
+			fprintf(pFile, "At time %d ", currentTime);
+			fprintf(pFile, "process %d resumed ", p_scheduledPCB->id);
+			fprintf(pFile, "arr %d ", p_scheduledPCB->arrivalTime);
+			fprintf(pFile, "total %d ", p_scheduledPCB->executionTime);
+			fprintf(pFile, "remain %d ", p_scheduledPCB->remainingTime);
+			fprintf(pFile, "wait %d\n", p_scheduledPCB->waitingTime);
+			return;
+	}
+}
+
+#if defined(SWAPPING) || defined(COMPACTION)
+// returns true if the scheduled process waits for the swap I/O or compaction made for it during this time step
+bool waitForMemoryOperations(struct process *p_process)
+{
+	#ifdef SWAPPING
+		if (waitForSwapIO(p_process))
+		{
+			return true;
+		}
+	#endif
+	#ifdef COMPACTION
+		if (waitForCompaction(p_process))
+		{
+			return true;
+		}
+	#endif
+	return false;
+}
+#endif
+
+void schedulerHPF(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process **p_scheduledProcess, struct PCB **p_scheduledPCB, int currentTime, int *processTable, int PCB_sem, int *processesFinished, FILE *pFile, struct memUnit *memory, FILE *pMemFile)
+{
+	// reset processArrival bool
+	p_readyQueue->processArrival = false;
+	
+	if ((*p_scheduledProcess) != NULL) // if a process is running
+	{
+		// update process and PCB data
+		decrementRemainingTime(p_readyQueue, p_processBufferStart, (*p_scheduledProcess));
+		(*p_scheduledPCB)->remainingTime--;
+		#ifdef BACKFILLING
+			updateBackfillResident((*p_scheduledProcess));
+		#endif
+		(*p_scheduledPCB)->waitingTime = (currentTime - (*p_scheduledPCB)->arrivalTime) - ((*p_scheduledPCB)->executionTime - (*p_scheduledPCB)->remainingTime);
+		
+		if ((*p_scheduledProcess)->remainingTime <= 0) // if the process finished execution
+		{			
+			#ifdef PRINTING
+				printf("Scheduler: Process %d finished\n", (*p_scheduledPCB)->id);
+			#endif			
+			// increment number of finished processes
+			(*processesFinished)++;
+			
+			// write log
+			writeLog(pFile, currentTime, (*p_scheduledPCB), FINISHED);
+			
+			// delete PCB
+			deletePCB(processTable, (*p_scheduledPCB));
+			
+			// write mem log and deallocate process
+			writeMemLog(pMemFile, currentTime, (*p_scheduledProcess), FREED);
+			#ifdef PRINTING
+				printf("Memory Manager: Process %d freed from %d to %d\n", (*p_scheduledProcess)->id, (*p_scheduledProcess)->allocatedMemUnit->start, (*p_scheduledProcess)->allocatedMemUnit->start + (*p_scheduledProcess)->allocationSize - 1);
+			#endif
+			deallocate((*p_scheduledProcess));
+			#ifdef SWAPPING
+				removeResident((*p_scheduledProcess)->id - 1);
+			#endif
+			#ifdef BACKFILLING
+				removeBackfillResident((*p_scheduledProcess));
+			#endif
+			
+			// dequeue process
+			dequeue(p_readyQueue, p_processBufferStart, (*p_scheduledProcess));
+			
+			if (p_readyQueue->head != -1) // if  ready queue is not empty
+			{
+				// schedule next process with highest priority that fits in memory and allocate memory for it
+				(*p_scheduledProcess) = scheduleFromReadyQueueHPF(p_readyQueue, p_processBufferStart, pMemFile, currentTime, memory);
+			}
+			else // process finished and ready queue is empty
+			{			
+				(*p_scheduledProcess) = NULL;
+			}
+			
+			if ((*p_scheduledProcess) != NULL)
+			{
+				// start or resume process with its PCB and write log
+				(*p_scheduledPCB) = dispatchProcess(pFile, processTable, PCB_sem, (*p_scheduledProcess), currentTime);
+			}
+			else
+			{
+				#ifdef PRINTING
+					printf("Scheduler: No process is scheduled\n");
+				#endif
+			}
+		}
+		else
+		{
+			#ifdef PRINTING
+				printf("Scheduler: Process %d is running, remaining time = %d\n", (*p_scheduledProcess)->id, (*p_scheduledProcess)->remainingTime);
+			#endif
+		}
+	}
+	else // no process running
+	{		
+		if (p_readyQueue->head != -1) // if  ready queue is not empty
+		{			
+			// schedule next process with highest priority that fits in memory and allocate memory for it
+			(*p_scheduledProcess) = scheduleFromReadyQueueHPF(p_readyQueue, p_processBufferStart, pMemFile, currentTime, memory);
+
+			// start or resume process with its PCB and write log
+			if ((*p_scheduledProcess) != NULL)
+			{
+				(*p_scheduledPCB) = dispatchProcess(pFile, processTable, PCB_sem, (*p_scheduledProcess), currentTime);
+			}
+		}
+		else
+		{
+			#ifdef PRINTING
+				printf("Scheduler: No process is scheduled\n");
+			#endif
+		}
+	}
+}
+
+void schedulerSRTN(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process **p_scheduledProcess, struct PCB **p_scheduledPCB, int currentTime, int *processTable, int PCB_sem, int *processesFinished, FILE *pFile, struct memUnit *memory, FILE *pMemFile, struct waitingQueue *waitingList)
+{
+	if ((*p_scheduledProcess) != NULL) // if a process is running
+	{
+		#if defined(SWAPPING) || defined(COMPACTION)
+			// the process does not run (or get preempted) until the memory operations made for it are done
+			if (waitForMemoryOperations(*p_scheduledProcess))
+			{
+				(*p_scheduledPCB)->waitingTime = (currentTime - (*p_scheduledPCB)->arrivalTime) - ((*p_scheduledPCB)->executionTime - (*p_scheduledPCB)->remainingTime);
+				return;
+			}
+		#endif
+		
+		// update process and PCB data
+		decrementRemainingTime(p_readyQueue, p_processBufferStart, (*p_scheduledProcess));
+		(*p_scheduledPCB)->remainingTime--;
+		#ifdef BACKFILLING
+			updateBackfillResident((*p_scheduledProcess));
+		#endif
+		(*p_scheduledPCB)->waitingTime = (currentTime - (*p_scheduledPCB)->arrivalTime) - ((*p_scheduledPCB)->executionTime - (*p_scheduledPCB)->remainingTime);
+		
+		if ((*p_scheduledProcess)->remainingTime <= 0) // if the process finished execution
+		{
+			// reset processArrival bool
+			p_readyQueue->processArrival = false;
+		
+			#ifdef PRINTING
+				printf("Scheduler: Process %d finished\n", (*p_scheduledPCB)->id);
+			#endif			
+			// increment number of finished processes
+			(*processesFinished)++;
+			
+			// write log
+			writeLog(pFile, currentTime, (*p_scheduledPCB), FINISHED);
+			
+			// delete PCB
+			deletePCB(processTable, (*p_scheduledPCB));
+			
+			// write mem log and deallocate process			
+			writeMemLog(pMemFile, currentTime, (*p_scheduledProcess), FREED);
+			#ifdef PRINTING
+				printf("Memory Manager: Process %d freed from %d to %d\n", (*p_scheduledProcess)->id, (*p_scheduledProcess)->allocatedMemUnit->start, (*p_scheduledProcess)->allocatedMemUnit->start + (*p_scheduledProcess)->allocationSize - 1);
+			#endif
+			deallocate((*p_scheduledProcess));
+			#ifdef SWAPPING
+				removeResident((*p_scheduledProcess)->id - 1);
+			#endif
+			#ifdef BACKFILLING
+				removeBackfillResident((*p_scheduledProcess));
+			#endif
+			
+			// dequeue process
+			dequeue(p_readyQueue, p_processBufferStart, (*p_scheduledProcess));
+			
+			if ((p_readyQueue->head != -1) || (waitingList->count != 0)) // if  ready queue is not empty or waiting list is not empty
+			{
+				// schedule next process
+				if (scheduleFromWaitingList(waitingList, p_scheduledProcess, pMemFile, currentTime, memory))
+				{
+					enqueue(p_readyQueue, p_processBufferStart, *p_scheduledProcess, ((*p_scheduledProcess)->id - 1), SRTN);
+				}
+				else
+				{
+					scheduleFromReadyQueue(p_readyQueue, p_processBufferStart, waitingList, p_scheduledProcess, pMemFile, currentTime, memory);
+				}				
+								
+				// start or resume process with its PCB and write log (unless no process fits in memory)
+				if ((*p_scheduledProcess) != NULL)
+				{
+					(*p_scheduledPCB) = dispatchProcess(pFile, processTable, PCB_sem, (*p_scheduledProcess), currentTime);
+				}
+			}
+			else // process finished and ready queue and waiting list are empty
+			{
+				(*p_scheduledProcess) = NULL;
+				#ifdef PRINTING
+					printf("Scheduler: No process is scheduled\n");
+				#endif
+			}
+		}
+		else if (p_readyQueue->processArrival)
+		{
+			// reset processArrival bool
+			p_readyQueue->processArrival = false;
+					
+			if ((p_processBufferStart + p_readyQueue->head) != (*p_scheduledProcess)) // if there is a new head
+			{
+				// preempt running process
+				(*p_scheduledPCB)->state = WAITING;
+				#ifdef PRINTING
+					printf("Scheduler: Process %d is preempted\n", (*p_scheduledProcess)->id);
+				#endif
+				// write log
+				writeLog(pFile, currentTime, (*p_scheduledPCB), STOPPED);				
+							
+				// schedule next process
+				scheduleFromReadyQueue(p_readyQueue, p_processBufferStart, waitingList, p_scheduledProcess, pMemFile, currentTime, memory);
+				
+				// start or resume process with its PCB and write log (unless no process fits in memory)
+				if ((*p_scheduledProcess) != NULL)
+				{
+					(*p_scheduledPCB) = dispatchProcess(pFile, processTable, PCB_sem, (*p_scheduledProcess), currentTime);
+				}
+			}
+			else
+			{
+				#ifdef PRINTING
+					printf("Scheduler: Process %d is running, remaining time = %d\n", (*p_scheduledProcess)->id, (*p_scheduledProcess)->remainingTime);
+				#endif
+			}
+		}
+		else
+		{
+			#ifdef PRINTING
+				printf("Scheduler: Process %d is running, remaining time = %d\n", (*p_scheduledProcess)->id, (*p_scheduledProcess)->remainingTime);
+			#endif
+		}
+	}
+	else
+	{
+		if ((p_readyQueue->head != -1) || (waitingList->count != 0)) // if  ready queue is not empty or waiting list is not empty
+		{
+			// reset processArrival bool
+			p_readyQueue->processArrival = false;
+		
+			// schedule next process (the waiting list is retried on an idle CPU, as memory can be
+			// freed after the last process finished)
+			if (scheduleFromWaitingList(waitingList, p_scheduledProcess, pMemFile, currentTime, memory))
+			{
+				enqueue(p_readyQueue, p_processBufferStart, *p_scheduledProcess, ((*p_scheduledProcess)->id - 1), SRTN);
+			}
+			else
+			{
+				scheduleFromReadyQueue(p_readyQueue, p_processBufferStart, waitingList, p_scheduledProcess, pMemFile, currentTime, memory);
+			}
+
+			// start or resume process with its PCB and write log (unless no process fits in memory)
+			if ((*p_scheduledProcess) != NULL)
+			{
+				(*p_scheduledPCB) = dispatchProcess(pFile, processTable, PCB_sem, (*p_scheduledProcess), currentTime);
+			}
+		}
+		else
+		{
+			#ifdef PRINTING
+				printf("Scheduler: No process is scheduled\n");
+			#endif
+		}
+	}
+}
+
+void schedulerRR(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct process **p_scheduledProcess, struct PCB **p_scheduledPCB, int currentTime, int *processTable, int PCB_sem, int *processesFinished, int quantum, int *processQuantum, FILE *pFile, struct memUnit *memory, FILE *pMemFile, struct waitingQueue *waitingList)
+{	
+	// reset processArrival bool
+	p_readyQueue->processArrival = false;
+
+	if ((*p_scheduledProcess) != NULL) // if a process is running
+	{
+		#if defined(SWAPPING) || defined(COMPACTION)
+			// the process does not run (or use its quantum) until the memory operations made for it are done
+			if (waitForMemoryOperations(*p_scheduledProcess))
+			{
+				(*p_scheduledPCB)->waitingTime = (currentTime - (*p_scheduledPCB)->arrivalTime) - ((*p_scheduledPCB)->executionTime - (*p_scheduledPCB)->remainingTime);
+				return;
+			}
+		#endif
+		
+		// update process and PCB data
+		decrementRemainingTime(p_readyQueue, p_processBufferStart, (*p_scheduledProcess));
+		(*p_scheduledPCB)->remainingTime--;
+		#ifdef BACKFILLING
+			updateBackfillResident((*p_scheduledProcess));
+		#endif
+		(*p_scheduledPCB)->waitingTime = (currentTime - (*p_scheduledPCB)->arrivalTime) - ((*p_scheduledPCB)->executionTime - (*p_scheduledPCB)->remainingTime);
+		(*processQuantum)++;
+		
+		if ((*p_scheduledProcess)->remainingTime <= 0) // if the process finished execution
+		{		
+			#ifdef PRINTING
+				printf("Scheduler: Process %d finished\n", (*p_scheduledPCB)->id);
+			#endif			
+			// increment number of finished processes
+			(*processesFinished)++;
+			
+			// write log
+			writeLog(pFile, currentTime, (*p_scheduledPCB), FINISHED);
+			
+			// delete PCB
+			deletePCB(processTable, (*p_scheduledPCB));
+			
+			// write mem log and deallocate process
+			writeMemLog(pMemFile, currentTime, (*p_scheduledProcess), FREED);
+			#ifdef PRINTING
+				printf("Memory Manager: Process %d freed from %d to %d\n", (*p_scheduledProcess)->id, (*p_scheduledProcess)->allocatedMemUnit->start, (*p_scheduledProcess)->allocatedMemUnit->start + (*p_scheduledProcess)->allocationSize - 1);
+			#endif
+			deallocate((*p_scheduledProcess));
+			#ifdef SWAPPING
+				removeResident((*p_scheduledProcess)->id - 1);
+			#endif
+			#ifdef BACKFILLING
+				removeBackfillResident((*p_scheduledProcess));
+			#endif			
+			
+			if ((p_readyQueue->head != -1) || (waitingList->count != 0)) // if  ready queue is not empty or waiting list is not empty
+			{
+				// reset processQuantum
+				(*processQuantum) = 0;
+				
+				// schedule next process
+				if (!scheduleFromWaitingList(waitingList, p_scheduledProcess, pMemFile, currentTime, memory))
+				{
+					scheduleFromReadyQueue(p_readyQueue, p_processBufferStart, waitingList, p_scheduledProcess, pMemFile, currentTime, memory);
+					if ((*p_scheduledProcess) != NULL)
+					{
+						dequeue(p_readyQueue, p_processBufferStart, (*p_scheduledProcess));
+					}
+				}				
+								
+				// start or resume process with its PCB and write log (unless no process fits in memory)
+				if ((*p_scheduledProcess) != NULL)
+				{
+					(*p_scheduledPCB) = dispatchProcess(pFile, processTable, PCB_sem, (*p_scheduledProcess), currentTime);
+				}
+			}
+			else // process finished and ready queue is empty
+			{
+				(*p_scheduledProcess) = NULL;
+				#ifdef PRINTING
+					printf("Scheduler: No process is scheduled\n");
+				#endif
+			}
+		}
+		else if ((*processQuantum) == quantum)
+		{
+			// reset processQuantum
+			(*processQuantum) = 0;
+			
+			#ifdef PRINTING
+				printf("Scheduler: Process %d is preempted\n", (*p_scheduledProcess)->id);
+			#endif
+			// write log
+			writeLog(pFile, currentTime, (*p_scheduledPCB), STOPPED);
+			
+			// enqueue preempted process
+			enqueue(p_readyQueue, p_processBufferStart, (*p_scheduledProcess), ((*p_scheduledProcess)->id - 1), RR);
+			
+			// schedule and dequeue next process
+			if (!scheduleFromWaitingList(waitingList, p_scheduledProcess, pMemFile, currentTime, memory))
+			{
+				scheduleFromReadyQueue(p_readyQueue, p_processBufferStart, waitingList, p_scheduledProcess, pMemFile, currentTime, memory);
+				dequeue(p_readyQueue, p_processBufferStart, (*p_scheduledProcess));
+			}
+			
+			// start or resume process with its PCB and write log (unless no process fits in memory)
+			if ((*p_scheduledProcess) != NULL)
+			{
+				(*p_scheduledPCB) = dispatchProcess(pFile, processTable, PCB_sem, (*p_scheduledProcess), currentTime);
+			}
+		}
+		else
+		{
+			#ifdef PRINTING
+				printf("Scheduler: Process %d is running, remaining time = %d\n", (*p_scheduledProcess)->id, (*p_scheduledProcess)->remainingTime);
+			#endif
+		}
+	}
+	else
+	{
+		if ((p_readyQueue->head != -1) || (waitingList->count != 0)) // if  ready queue is not empty or waiting list is not empty
+		{
+			// reset processQuantum
+			(*processQuantum) = 0;
+		
+			// schedule and dequeue next process (the waiting list is retried on an idle CPU, as
+			// memory can be freed after the last process finished)
+			if (!scheduleFromWaitingList(waitingList, p_scheduledProcess, pMemFile, currentTime, memory))
+			{
+				scheduleFromReadyQueue(p_readyQueue, p_processBufferStart, waitingList, p_scheduledProcess, pMemFile, currentTime, memory);
+				if ((*p_scheduledProcess) != NULL)
+				{
+					dequeue(p_readyQueue, p_processBufferStart, (*p_scheduledProcess));
+				}
+			}
+
+			// start or resume process with its PCB and write log (unless no process fits in memory)
+			if ((*p_scheduledProcess) != NULL)
+			{
+				(*p_scheduledPCB) = dispatchProcess(pFile, processTable, PCB_sem, (*p_scheduledProcess), currentTime);
+			}
+		}
+		else
+		{
+			#ifdef PRINTING
+				printf("Scheduler: No process is scheduled\n");
+			#endif
+		}
+	}
+}
+
+// starts the scheduled process if it is scheduled for the first time or resumes it, writes the
+// log and returns its PCB
+struct PCB *dispatchProcess(FILE *pFile, int *processTable, int PCB_sem, struct process *p_process, int currentTime)
+{
+	struct PCB *p_PCB;
+	if (p_process->remainingTime == p_process->runningTime) // if process is scheduled for the first time
+	{
+		#ifdef PRINTING
+			printf("Scheduler: Process %d is scheduled, remaining time = %d\n", p_process->id, p_process->remainingTime);
+		#endif
+		
+		// start process with its PCB
+		p_PCB = startProcess(processTable, PCB_sem, p_process, currentTime);
+		
+		// write log
+		writeLog(pFile, currentTime, p_PCB, STARTED);
+	}
+	else
+	{
+		// select PCB
+		p_PCB = selectPCB(processTable, p_process);
+		p_PCB->state = RUNNING;
+		p_PCB->waitingTime = (currentTime - p_PCB->arrivalTime) - (p_PCB->executionTime - p_PCB->remainingTime);
+		
+		#ifdef PRINTING
+			printf("Scheduler: Process %d is resumed, remaining time = %d\n", p_process->id, p_process->remainingTime);
+		#endif
+		// write log
+		writeLog(pFile, currentTime, p_PCB, RESUMED);
+	}
+	return p_PCB;
+}
+
+void writeMemLog(FILE *pFile, int currentTime, struct process* p_process, int logType)
+{
+	HOT_PATH_TIMER(LOG_WRITE_OPERATION);
+	#ifdef TRACE_EXPORT
+		char *events[] = {"allocated", "freed", "swapped out", "swapped in"};
+		traceMemory(currentTime, events[logType], p_process->id, p_process->memSize, p_process->allocatedMemUnit->start, p_process->allocatedMemUnit->start + p_process->allocationSize - 1);
+	#endif
+	#ifdef BINARY_LOG
+		logEvent(MEMORY_EVENT + logType, currentTime, p_process->id, p_process->memSize, p_process->allocatedMemUnit->start, p_process->allocatedMemUnit->start + p_process->allocationSize - 1, 0, 0);
+		return;
+	#endif
+	switch (logType)
+	{
+		case ALLOCATED:
+			fprintf(pFile, "At time %d allocated %d bytes for process %d from %d to %d\n", currentTime, p_process->memSize, p_process->id, p_process->allocatedMemUnit->start, p_process->allocatedMemUnit->start + p_process->allocationSize - 1);
+			break;
+			
+		case FREED:
+			fprintf(pFile, "At time %d freed %d bytes from process %d from %d to %d\n", currentTime, p_process->memSize, p_process->id, p_process->allocatedMemUnit->start, p_process->allocatedMemUnit->start + p_process->allocationSize - 1);
+			break;
+			
+		case SWAPPED_OUT:
+			fprintf(pFile, "At time %d swapped out %d bytes of process %d from %d to %d\n", currentTime, p_process->memSize, p_process->id, p_process->allocatedMemUnit->start, p_process->allocatedMemUnit->start + p_process->allocationSize - 1);
+			break;
+			
+		case SWAPPED_IN:
+			fprintf(pFile, "At time %d swapped in %d bytes of process %d from %d to %d\n", currentTime, p_process->memSize, p_process->id, p_process->allocatedMemUnit->start, p_process->allocatedMemUnit->start + p_process->allocationSize - 1);
+			break;
+	}
+}
+
+bool tryAllocate(FILE *pFile, int currentTime, struct memUnit *memory, struct process *p_process)
+{
+	bool processAllocated = allocate(memory, p_process);
+		
+	if (processAllocated)
+	{
+		writeMemLog(pFile, currentTime, p_process, ALLOCATED);
+		#ifdef PRINTING
+			printf("Memory Manager: Process %d allocated from %d to %d\n", p_process->id, p_process->allocatedMemUnit->start, p_process->allocatedMemUnit->start + p_process->allocationSize - 1);
+		#endif
+		#ifdef BACKFILLING
+			addBackfillResident(p_process);
+		#endif
+		#ifdef SWAPPING
+			swapIn(pFile, currentTime, p_process);
+		#endif
+		return true;
+	}
+	else
+	{
+		if (p_process->allocatedMemUnit == NULL)
+		{
+			#ifdef PRINTING
+				printf("Memory Manager: Could do not allocate memory for process %d\n", p_process->id);
+			#endif
+			return false;
+		}
+		else
+		{
+			splitAllocate(p_process);
+			writeMemLog(pFile, currentTime, p_process, ALLOCATED);
+			#ifdef PRINTING
+				printf("Memory Manager: Process %d allocated from %d to %d\n", p_process->id, p_process->allocatedMemUnit->start, p_process->allocatedMemUnit->start + p_process->allocationSize - 1);
+			#endif
+			#ifdef BACKFILLING
+				addBackfillResident(p_process);
+			#endif
+			#ifdef SWAPPING
+				swapIn(pFile, currentTime, p_process);
+			#endif
+			return true;
+		}
+	}
+}
+
+bool scheduleFromWaitingList(struct waitingQueue *waitingList, struct process **p_scheduledProcess, FILE *pFile, int currentTime, struct memUnit *memory)
+{
+	HOT_PATH_TIMER(WAITING_LIST_SCAN_OPERATION);
+	
+	// corner case: waiting list empty
+	if (waitingList->count == 0)
+	{
+		return false;
+	}
+	
+	#ifdef COMPACTION
+		// relocate resident processes when the earliest waiting process is only blocked by fragmentation
+		struct waitingProcess *p_earliestWaitingProcess = NULL;
+		for (int order = 0; order < ALLOCATION_ORDERS; order++)
+		{
+			struct waitingProcess *p_headWaitingProcess = waitingList->classes[order].head;
+			if ((p_headWaitingProcess != NULL) && ((p_earliestWaitingProcess == NULL) || (p_headWaitingProcess->sequence < p_earliestWaitingProcess->sequence)))
+			{
+				p_earliestWaitingProcess = p_headWaitingProcess;
+			}
+		}
+		compactFor(pFile, currentTime, memory, p_earliestWaitingProcess->p_process);
+	#endif
+	
+	// select the earliest waiting process among the class heads that may fit in memory (the
+	// variable-size allocators round sizes to SMALLEST_ALLOCATION_UNIT only and the slabs hold
+	// small processes in partial slabs, so each head is tested with its own size)
+	struct waitingProcess *p_selectedWaitingProcess = NULL;
+	for (int order = 0; order < ALLOCATION_ORDERS; order++)
+	{
+		HOT_PATH_WORK(WAITING_LIST_SCAN_OPERATION, 1);
+		struct waitingProcess *p_headWaitingProcess = waitingList->classes[order].head;
+		if ((p_headWaitingProcess != NULL) && !mayFit(memory, p_headWaitingProcess->p_process->allocationSize))
+		{
+			continue;
+		}
+		#ifdef BACKFILLING
+			// processes behind the earliest waiting process may not delay its reservation
+			if ((p_headWaitingProcess != NULL) && !canBackfill(waitingList, p_headWaitingProcess->p_process))
+			{
+				continue;
+			}
+		#endif
+		if ((p_headWaitingProcess != NULL) && ((p_selectedWaitingProcess == NULL) || (p_headWaitingProcess->sequence < p_selectedWaitingProcess->sequence)))
+		{
+			p_selectedWaitingProcess = p_headWaitingProcess;
+		}
+	}
+	
+	if ((p_selectedWaitingProcess != NULL) && tryAllocate(pFile, currentTime, memory, p_selectedWaitingProcess->p_process))
+	{
+		*p_scheduledProcess = p_selectedWaitingProcess->p_process;
+		removeFromWaitingList(waitingList, p_selectedWaitingProcess);
+		#ifdef PRINTING
+			printf("Memory Manager: Process %d removed from waiting list\n", (*p_scheduledProcess)->id);
+		#endif
+		return true;
+	}
+	return false;
+}
+
+// returns the first process of the ready queue that holds its memory or is allocated memory, NULL if
+// no process fits (HPF runs one process at a time, so only processes that blocked on an allocation
+// request hold memory while they are not running)
+struct process *scheduleFromReadyQueueHPF(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, FILE *pFile, int currentTime, struct memUnit *memory)
+{
+	for (int processIndex = p_readyQueue->head; processIndex != -1; processIndex = nextInReadyQueue(p_readyQueue, p_processBufferStart, processIndex))
+	{
+		struct process *p_currentProcess = p_processBufferStart + processIndex;
+		if ((p_currentProcess->allocatedMemUnit != NULL) || tryAllocate(pFile, currentTime, memory, p_currentProcess))
+		{
+			return p_currentProcess;
+		}
+	}
+	return NULL;
+}
+
+void scheduleFromReadyQueue(struct readyQueue *p_readyQueue, struct process *p_processBufferStart, struct waitingQueue *waitingList, struct process **p_scheduledProcess, FILE *pFile, int currentTime, struct memUnit *memory)
+{
+	*p_scheduledProcess = NULL;
+	
+	// processes that do not fit in memory are moved from the ready queue to the waiting list
+	int processIndex = p_readyQueue->head;
+	while (processIndex != -1)
+	{
+		struct process *p_currentProcess = p_processBufferStart + processIndex;
+		processIndex = nextInReadyQueue(p_readyQueue, p_processBufferStart, processIndex);
+		if (p_currentProcess->allocatedMemUnit != NULL)
+		{
+			*p_scheduledProcess = p_currentProcess;
+			return;
+		}
+		#ifdef BACKFILLING
+			// processes may not take memory ahead of the earliest waiting process if they delay its reservation
+			else if (!canBackfill(waitingList, p_currentProcess))
+			{
+				// held back: kept in the ready queue, and the processes behind it are tried
+				continue;
+			}
+		#endif
+		else if (tryAllocate(pFile, currentTime, memory, p_currentProcess))
+		{
+			*p_scheduledProcess = p_currentProcess;
+			return;
+		}
+		#ifdef COMPACTION
+			// relocate resident processes when the free memory is only fragmented
+			else if (compactFor(pFile, currentTime, memory, p_currentProcess) && tryAllocate(pFile, currentTime, memory, p_currentProcess))
+			{
+				*p_scheduledProcess = p_currentProcess;
+				return;
+			}
+		#endif
+		#ifdef SWAPPING
+			// swap out resident processes to make room instead of waiting
+			else if (swapOutFor(pFile, currentTime, memory, p_processBufferStart, p_currentProcess) && tryAllocate(pFile, currentTime, memory, p_currentProcess))
+			{
+				*p_scheduledProcess = p_currentProcess;
+				return;
+			}
+		#endif
+		dequeue(p_readyQueue, p_processBufferStart, p_currentProcess);
+		addToWaitingList(waitingList, p_currentProcess);
+		#ifdef PRINTING
+			printf("Memory Manager: Process %d added to waiting list\n", p_currentProcess->id);
+		#endif
+	}
+}
@@ -0,0 +1,288 @@
+// File-backed swap space. When a process does not fit in memory, resident processes that
+// are not running are swapped out to a swap file until it fits. Their memory images are
+// written in batches with pwritev and read back with pread when they are scheduled again.
+// The modelled I/O time of the writes made for a process and of its read delays its start.
+#include <fcntl.h>
+#include <string.h>
+#include <sys/uio.h>
+
+// output files
+#define SWAP_FILE "swap.bin"
+
+// swap I/O model (can be overridden with -D)
+#ifndef SWAP_LATENCY_TICKS
+#define SWAP_LATENCY_TICKS 1
+#endif
+#ifndef SWAP_BYTES_PER_TICK
+#define SWAP_BYTES_PER_TICK 512
+#endif
+
+struct swapState
+{
+	int fd;
+	char memoryImage[MEMORY_SIZE];	// contents of the simulated memory
+
+	// slot allocator: one free list of slot offsets per allocation order
+	long *freeSlots[ALLOCATION_ORDERS];
+	int freeSlotsCount[ALLOCATION_ORDERS];
+	long fileSize;
+	long *slotOffset;	// offset of the swap slot of each process, -1 if not swapped out
+
+	// resident processes in allocation order
+	int *residentNext;
+	int *residentPrev;
+	int residentHead;
+	int residentTail;
+
+	// swap I/O ticks each process waits for before it runs, indexed by process index
+	int *ioTicksLeft;
+
+	// statistics
+	int swapOuts;
+	int swapIns;
+	int writes;
+	long ioTicks;
+};
+
+struct swapState swap;
+
+// defined by the scheduler
+void writeMemLog(FILE *pFile, int currentTime, struct process* p_process, int logType);
+
+void initSwap(int N)
+{
+	swap.fd = open(instancePath(SWAP_FILE), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (swap.fd == -1)
+	{
+		perror("Error in opening swap file");
+		exit(-1);
+	}
+	for (int i = 0; i < ALLOCATION_ORDERS; i++)
+	{
+		swap.freeSlots[i] = (long *) malloc(N * sizeof(long));
+		swap.freeSlotsCount[i] = 0;
+	}
+	swap.fileSize = 0;
+	swap.slotOffset = (long *) malloc(N * sizeof(long));
+	swap.residentNext = (int *) malloc(N * sizeof(int));
+	swap.residentPrev = (int *) malloc(N * sizeof(int));
+	swap.ioTicksLeft = (int *) calloc(N, sizeof(int));
+	for (int i = 0; i < N; i++)
+	{
+		swap.slotOffset[i] = -1;
+	}
+	swap.residentHead = -1;
+	swap.residentTail = -1;
+}
+
+void destroySwap()
+{
+	close(swap.fd);
+	unlink(instancePath(SWAP_FILE));
+}
+
+void addResident(int processIndex)
+{
+	swap.residentPrev[processIndex] = swap.residentTail;
+	swap.residentNext[processIndex] = -1;
+	if (swap.residentTail == -1)
+	{
+		swap.residentHead = processIndex;
+	}
+	else
+	{
+		swap.residentNext[swap.residentTail] = processIndex;
+	}
+	swap.residentTail = processIndex;
+}
+
+void removeResident(int processIndex)
+{
+	int prev = swap.residentPrev[processIndex];
+	int next = swap.residentNext[processIndex];
+	if (prev == -1)
+	{
+		swap.residentHead = next;
+	}
+	else
+	{
+		swap.residentNext[prev] = next;
+	}
+	if (next == -1)
+	{
+		swap.residentTail = prev;
+	}
+	else
+	{
+		swap.residentPrev[next] = prev;
+	}
+}
+
+long allocateSlot(int allocationSize)
+{
+	int order = allocationOrder(allocationSize);
+	if (swap.freeSlotsCount[order] > 0)
+	{
+		return swap.freeSlots[order][--swap.freeSlotsCount[order]];
+	}
+
+	// append a new slot to the swap file, large enough for any size of the same order
+	long offset = swap.fileSize;
+	swap.fileSize += SMALLEST_ALLOCATION_UNIT << order;
+	return offset;
+}
+
+void freeSlot(long offset, int allocationSize)
+{
+	int order = allocationOrder(allocationSize);
+	swap.freeSlots[order][swap.freeSlotsCount[order]++] = offset;
+}
+
+int swapTicks(int bytes)
+{
+	return SWAP_LATENCY_TICKS + ((bytes + SWAP_BYTES_PER_TICK - 1) / SWAP_BYTES_PER_TICK);
+}
+
+// writes a batch of images, merging the ones with adjacent slots into a single pwritev, and
+// returns its I/O ticks
+int writeBatch(struct iovec *images, long *offsets, int count)
+{
+	// sort images by slot offset
+	for (int i = 1; i < count; i++)
+	{
+		for (int j = i; (j > 0) && (offsets[j] < offsets[j - 1]); j--)
+		{
+			struct iovec image = images[j];
+			long offset = offsets[j];
+			images[j] = images[j - 1];
+			offsets[j] = offsets[j - 1];
+			images[j - 1] = image;
+			offsets[j - 1] = offset;
+		}
+	}
+
+	int ticks = 0;
+	int start = 0;
+	while (start < count)
+	{
+		int end = start + 1;
+		long bytes = images[start].iov_len;
+		while ((end < count) && (offsets[end] == offsets[start] + bytes))
+		{
+			bytes += images[end].iov_len;
+			end++;
+		}
+		if (pwritev(swap.fd, images + start, end - start, offsets[start]) != bytes)
+		{
+			perror("Error in writing swap file");
+		}
+		swap.writes++;
+		ticks += swapTicks(bytes);
+		start = end;
+	}
+	swap.ioTicks += ticks;
+	return ticks;
+}
+
+// swaps out resident processes (oldest allocation first) until the given process fits in memory
+bool swapOutFor(FILE *pFile, int currentTime, struct memUnit *memory, struct process *p_processBufferStart, struct process *p_process)
+{
+	// the residents hold all allocated memory, so the process fits once they are all swapped out
+	// unless it is larger than the memory
+	if (p_process->allocationSize > MEMORY_SIZE)
+	{
+		return false;
+	}
+
+	struct iovec images[MEMORY_SIZE / SMALLEST_ALLOCATION_UNIT];
+	long offsets[MEMORY_SIZE / SMALLEST_ALLOCATION_UNIT];
+	int count = 0;
+
+	int processIndex = swap.residentHead;
+	while (!mayFit(memory, p_process->allocationSize) && (processIndex != -1))
+	{
+		struct process *p_victim = p_processBufferStart + processIndex;
+		int nextIndex = swap.residentNext[processIndex];
+		if (p_victim != p_process)
+		{
+			// queue the image of the victim and free its memory
+			swap.slotOffset[processIndex] = allocateSlot(p_victim->allocationSize);
+			images[count].iov_base = swap.memoryImage + p_victim->allocatedMemUnit->start;
+			images[count].iov_len = p_victim->allocationSize;
+			offsets[count] = swap.slotOffset[processIndex];
+			count++;
+			writeMemLog(pFile, currentTime, p_victim, SWAPPED_OUT);
+			#ifdef PRINTING
+				printf("Memory Manager: Process %d swapped out\n", p_victim->id);
+			#endif
+			deallocate(p_victim);
+			removeResident(processIndex);
+			#ifdef BACKFILLING
+				removeBackfillResident(p_victim);
+			#endif
+			swap.swapOuts++;
+		}
+		processIndex = nextIndex;
+	}
+
+	// images stay in memory until the new process is allocated, so they can be written as one
+	// batch, which the process waits for if it fits
+	int ticks = writeBatch(images, offsets, count);
+	if (!mayFit(memory, p_process->allocationSize))
+	{
+		return false;
+	}
+	swap.ioTicksLeft[p_process->id - 1] += ticks;
+	return true;
+}
+
+// reads the image of a process that was swapped out into its new memory unit
+void swapIn(FILE *pFile, int currentTime, struct process *p_process)
+{
+	int processIndex = p_process->id - 1;
+	addResident(processIndex);
+	if (swap.slotOffset[processIndex] == -1)
+	{
+		// first allocation: fill the memory unit with the id of the process
+		memset(swap.memoryImage + p_process->allocatedMemUnit->start, p_process->id, p_process->allocationSize);
+		return;
+	}
+
+	if (pread(swap.fd, swap.memoryImage + p_process->allocatedMemUnit->start, p_process->allocationSize, swap.slotOffset[processIndex]) != p_process->allocationSize)
+	{
+		perror("Error in reading swap file");
+	}
+	freeSlot(swap.slotOffset[processIndex], p_process->allocationSize);
+	swap.slotOffset[processIndex] = -1;
+	swap.swapIns++;
+	swap.ioTicks += swapTicks(p_process->allocationSize);
+	swap.ioTicksLeft[processIndex] += swapTicks(p_process->allocationSize);
+	writeMemLog(pFile, currentTime, p_process, SWAPPED_IN);
+	#ifdef PRINTING
+		printf("Memory Manager: Process %d swapped in\n", p_process->id);
+	#endif
+}
+
+// returns true if the scheduled process is still waiting for its swap I/O, which takes one tick
+bool waitForSwapIO(struct process *p_process)
+{
+	int processIndex = p_process->id - 1;
+	if (swap.ioTicksLeft[processIndex] == 0)
+	{
+		return false;
+	}
+	swap.ioTicksLeft[processIndex]--;
+	#ifdef PRINTING
+		printf("Scheduler: Process %d is waiting for swap I/O\n", p_process->id);
+	#endif
+	return true;
+}
+
+void writeSwapPerformance(FILE *pFile)
+{
+	fprintf(pFile, "Swap outs = %d\n", swap.swapOuts);
+	fprintf(pFile, "Swap ins = %d\n", swap.swapIns);
+	fprintf(pFile, "Swap writes = %d\n", swap.writes);
+	fprintf(pFile, "Swap I/O time = %ld ticks\n", swap.ioTicks);
+	fprintf(pFile, "Swap file size = %ld bytes\n", swap.fileSize);
+}
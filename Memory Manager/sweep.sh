@@ -0,0 +1,113 @@
+#!/bin/bash
+# Runs a workload with every combination of scheduling algorithm, round robin quantum and memory
+# size in parallel, and collects the scheduler.perf results in one comparison table.
+#
+#   ./sweep.sh [-a "hpf srtn rr"] [-q "1 2 4 8"] [-m "1024 2048"] [-l ALLOCATOR] [-j JOBS]
+#              [-f FLAGS] [-o DIRECTORY] WORKLOAD
+#
+# The binaries are built once per memory size with FLAGS. Each simulation runs in its own
+# directory and its own session, because the process generator signals its whole process group
+# when it finishes, and with its own OSSIM_INSTANCE so that the IPC keys do not collide.
+
+algorithms="hpf srtn rr"
+quanta="1 2 4 8"
+memorySizes="1024"
+allocator="buddy"
+jobs=$(nproc)
+flags=""
+output="sweep"
+while getopts "a:q:m:l:j:f:o:" option; do
+	case $option in
+		a) algorithms=$OPTARG ;;
+		q) quanta=$OPTARG ;;
+		m) memorySizes=$OPTARG ;;
+		l) allocator=$OPTARG ;;
+		j) jobs=$OPTARG ;;
+		f) flags=$OPTARG ;;
+		o) output=$OPTARG ;;
+		*) exit 1 ;;
+	esac
+done
+shift $((OPTIND - 1))
+if [ $# -ne 1 ] || [ ! -f "$1" ]; then
+	echo "Usage: $0 [-a ALGORITHMS] [-q QUANTA] [-m MEMORY_SIZES] [-l ALLOCATOR] [-j JOBS] [-f FLAGS] [-o DIRECTORY] WORKLOAD"
+	exit 1
+fi
+workload=$(realpath "$1")
+sources=$(dirname "$(realpath "$0")")
+mkdir -p "$output"
+output=$(realpath "$output")
+
+# build the binaries for each memory size
+for memorySize in $memorySizes; do
+	build="$output/build-m$memorySize"
+	mkdir -p "$build"
+	cp "$sources"/*.c "$sources"/*.h "$sources"/Makefile "$build"
+	if ! make -s -C "$build" build FLAGS="$flags -DMEMORY_SIZE=$memorySize" >/dev/null 2>&1; then
+		echo "Build failed for memory size $memorySize"
+		exit 1
+	fi
+done
+
+# one run per algorithm and memory size, and per quantum for round robin
+runs=()
+for memorySize in $memorySizes; do
+	for algorithm in $algorithms; do
+		if [ "$algorithm" = "rr" ]; then
+			for quantum in $quanta; do
+				runs+=("$algorithm $quantum $memorySize")
+			done
+		else
+			runs+=("$algorithm 0 $memorySize")
+		fi
+	done
+done
+
+simulate() {
+	local instance=$1 algorithm=$2 quantum=$3 memorySize=$4
+	local run="$output/$algorithm-q$quantum-m$memorySize"
+	mkdir -p "$run"
+	for binary in process_generator.out scheduler.out clk.out process.out; do
+		ln -sf "$output/build-m$memorySize/$binary" "$run/$binary"
+	done
+	(cd "$run" && OSSIM_INSTANCE=$instance setsid -w ./process_generator.out "$workload" "$allocator" "$algorithm" "$quantum" >output.txt 2>&1 </dev/null)
+	echo "Finished $algorithm quantum $quantum memory $memorySize"
+}
+
+echo "Running ${#runs[@]} simulations, $jobs at a time"
+running=0
+for index in "${!runs[@]}"; do
+	if [ $running -ge "$jobs" ]; then
+		wait -n
+		running=$((running - 1))
+	fi
+	simulate $((index + 1)) ${runs[$index]} &
+	running=$((running + 1))
+done
+wait
+
+# comparison table
+table="$output/sweep.tsv"
+printf "algorithm\tquantum\tmemory\tCPU utilization\tavg WTA\tstd WTA\tp99 WTA\tavg waiting\tp99 waiting\tavg response\tavg turnaround\n" > "$table"
+for index in "${!runs[@]}"; do
+	set -- ${runs[$index]}
+	perf="$output/$1-q$2-m$3/scheduler.$((index + 1)).perf"
+	if [ ! -f "$perf" ]; then
+		printf "%s\t%s\t%s\tfailed\n" "$1" "$2" "$3" >> "$table"
+		continue
+	fi
+	awk -v algorithm="$1" -v quantum="$2" -v memory="$3" '
+		/^CPU utilization/ { utilization = $4 }
+		/^Std WTA/ { stdWTA = $4 }
+		/^WTA:/ { avgWTA = $3; p99WTA = $11 }
+		/^Waiting:/ { avgWaiting = $3; p99Waiting = $11 }
+		/^Response:/ { avgResponse = $3 }
+		/^Turnaround:/ { avgTurnaround = $3 }
+		END { gsub(",", "", avgWTA); gsub(",", "", p99WTA); gsub(",", "", avgWaiting); gsub(",", "", p99Waiting); gsub(",", "", avgResponse); gsub(",", "", avgTurnaround)
+			printf "%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\n", algorithm, quantum, memory, utilization, avgWTA, stdWTA, p99WTA, avgWaiting, p99Waiting, avgResponse, avgTurnaround }' "$perf" >> "$table"
+done
+if command -v column >/dev/null; then
+	column -t -s $'\t' "$table"
+else
+	cat "$table"
+fi
@@ -1,39 +1,539 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
 #include <time.h>
-#define null 0
+#include <unistd.h>
+#include <pthread.h>
+#include "workload.h"
 
-struct processData
+// Generates a workload of processes in arrival order. Without arguments it asks for the number of
+// processes and uses the original uniform distributions with a time seed. With options it is
+// seeded and non-interactive:
+//
+//   ./test_generator.out -n COUNT [-s SEED] [-o FILE] [-b] [-j THREADS]
+//       [-a uniform:MIN:MAX | poisson:RATE | mmpp:RATE_LOW:RATE_HIGH:SWITCH_LOW:SWITCH_HIGH]
+//       [-r uniform:MIN:MAX | lognormal:MU:SIGMA | pareto:XM:ALPHA]
+//       [-m uniform:MIN:MAX | zipf:S[:MAX]] [-p W0,W1,...,W10] [-d SLACK]
+//
+// The processes are generated in chunks of CHUNK_SIZE, each with its own random streams, so the
+// output only depends on the seed and not on the number of threads. The arrival times of a chunk
+// are offset by the total inter-arrival time of the chunks before it, which is computed in a first
+// pass that only draws the inter-arrival times.
+
+// processes per chunk (can be overridden with -D)
+#ifndef CHUNK_SIZE
+#define CHUNK_SIZE (1 << 16)
+#endif
+
+// longest text line: 6 numbers of up to 10 digits and their separators
+#define MAX_LINE 72
+
+#define MAX_PRIORITY 10
+#define MAX_MEM_SIZE 256
+#define MAX_RUNTIME 1000000000
+
+// distributions
+#define UNIFORM 0
+#define POISSON 1
+#define MMPP 2
+#define LOGNORMAL 3
+#define PARETO 4
+#define ZIPF 5
+
+struct workloadConfig
 {
-    int arrivaltime;
-    int priority;
-    int runningtime;
-    int id;
-    int memSize;
+	long count;
+	unsigned long long seed;
+	int threads;
+	int binary;
+	char *path;
+
+	int arrivals;
+	double arrivalParams[4];
+	int runtimes;
+	double runtimeParams[2];
+	int memSizes;
+	double memSizeParams[2];
+	double priorityCdf[MAX_PRIORITY + 1];
+	double memSizeCdf[MAX_MEM_SIZE];
+	double deadlineSlack;	// mean slack as a fraction of the runtime, 0 for no deadlines
 };
 
+struct workloadConfig config;
+
+struct chunk
+{
+	long index;
+	long first;
+	long count;
+	double startTime;
+	double duration;
+	char *buffer;
+	size_t length;
+};
+
+// splitmix64
+unsigned long long nextRandom(unsigned long long *p_state)
+{
+	unsigned long long z = (*p_state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+// independent streams of a chunk, so that options do not change the other fields
+#define GAP_STREAM 0
+#define FIELD_STREAM 1
+#define DEADLINE_STREAM 2
+
+unsigned long long chunkStream(long chunkIndex, int stream)
+{
+	unsigned long long state = config.seed * 0xD1B54A32D192ED03ULL + 3 * chunkIndex + stream;
+	nextRandom(&state);
+	return state;
+}
+
+double uniform01(unsigned long long *p_state)
+{
+	return (nextRandom(p_state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int uniformInt(unsigned long long *p_state, int min, int max)
+{
+	return min + nextRandom(p_state) % (max - min + 1);
+}
+
+double exponential(unsigned long long *p_state, double rate)
+{
+	return -log(1 - uniform01(p_state)) / rate;
+}
+
+double normal(unsigned long long *p_state)
+{
+	// Box-Muller
+	return sqrt(-2 * log(1 - uniform01(p_state))) * cos(2 * M_PI * uniform01(p_state));
+}
+
+// returns the first index whose cumulative probability reaches u
+int sampleCdf(double *cdf, int size, double u)
+{
+	int low = 0;
+	int high = size - 1;
+	while (low < high)
+	{
+		int middle = (low + high) / 2;
+		if (cdf[middle] >= u)
+		{
+			high = middle;
+		}
+		else
+		{
+			low = middle + 1;
+		}
+	}
+	return low;
+}
+
+// the MMPP state of a chunk starts from the stationary distribution
+int initialArrivalState(unsigned long long *p_state)
+{
+	if (config.arrivals != MMPP)
+	{
+		return 0;
+	}
+	double highFraction = config.arrivalParams[2] / (config.arrivalParams[2] + config.arrivalParams[3]);
+	return (uniform01(p_state) < highFraction) ? 1 : 0;
+}
+
+double nextGap(unsigned long long *p_state, int *p_arrivalState)
+{
+	switch (config.arrivals)
+	{
+		case POISSON:
+			return exponential(p_state, config.arrivalParams[0]);
+
+		case MMPP:
+		{
+			// the next arrival or state switch, whichever comes first
+			double gap = 0;
+			while (1)
+			{
+				double arrival = exponential(p_state, config.arrivalParams[*p_arrivalState]);
+				double change = exponential(p_state, config.arrivalParams[2 + *p_arrivalState]);
+				if (arrival <= change)
+				{
+					return gap + arrival;
+				}
+				gap += change;
+				*p_arrivalState ^= 1;
+			}
+		}
+
+		default:
+			return uniformInt(p_state, config.arrivalParams[0], config.arrivalParams[1]);
+	}
+}
+
+int nextRuntime(unsigned long long *p_state)
+{
+	double runtime;
+	switch (config.runtimes)
+	{
+		case LOGNORMAL:
+			runtime = ceil(exp(config.runtimeParams[0] + config.runtimeParams[1] * normal(p_state)));
+			break;
+
+		case PARETO:
+			runtime = ceil(config.runtimeParams[0] / pow(1 - uniform01(p_state), 1 / config.runtimeParams[1]));
+			break;
+
+		default:
+			return uniformInt(p_state, config.runtimeParams[0], config.runtimeParams[1]);
+	}
+	return (runtime < 1) ? 1 : (runtime > MAX_RUNTIME) ? MAX_RUNTIME : (int) runtime;
+}
+
+int nextMemSize(unsigned long long *p_state)
+{
+	if (config.memSizes == ZIPF)
+	{
+		return 1 + sampleCdf(config.memSizeCdf, config.memSizeParams[1], uniform01(p_state));
+	}
+	return uniformInt(p_state, config.memSizeParams[0], config.memSizeParams[1]);
+}
+
+void generateRecord(struct workloadRecord *p_record, long id, double *p_time, unsigned long long *p_gapState, int *p_arrivalState, unsigned long long *p_fieldState, unsigned long long *p_deadlineState)
+{
+	*p_time += nextGap(p_gapState, p_arrivalState);
+	p_record->id = id;
+	p_record->arrivalTime = (int) *p_time;
+	p_record->runningTime = nextRuntime(p_fieldState);
+	p_record->priority = sampleCdf(config.priorityCdf, MAX_PRIORITY + 1, uniform01(p_fieldState));
+	p_record->memSize = nextMemSize(p_fieldState);
+	p_record->deadline = 0;
+	if (config.deadlineSlack > 0)
+	{
+		double slack = p_record->runningTime * exponential(p_deadlineState, 1 / config.deadlineSlack);
+		p_record->deadline = p_record->arrivalTime + p_record->runningTime + (int) ceil(slack);
+	}
+}
+
+// writes the decimal digits of a non-negative number
+char *formatInt(char *p_out, int value)
+{
+	char digits[10];
+	int count = 0;
+	do
+	{
+		digits[count++] = '0' + value % 10;
+		value /= 10;
+	} while (value != 0);
+	while (count > 0)
+	{
+		*p_out++ = digits[--count];
+	}
+	return p_out;
+}
+
+// first pass: total inter-arrival time of a chunk
+void *measureChunk(void *arg)
+{
+	struct chunk *p_chunk = (struct chunk *) arg;
+	unsigned long long gapState = chunkStream(p_chunk->index, GAP_STREAM);
+	int arrivalState = initialArrivalState(&gapState);
+	double duration = 0;
+	for (long i = 0; i < p_chunk->count; i++)
+	{
+		duration += nextGap(&gapState, &arrivalState);
+	}
+	p_chunk->duration = duration;
+	return NULL;
+}
+
+// second pass: generate and format the processes of a chunk
+void *generateChunk(void *arg)
+{
+	struct chunk *p_chunk = (struct chunk *) arg;
+	unsigned long long gapState = chunkStream(p_chunk->index, GAP_STREAM);
+	unsigned long long fieldState = chunkStream(p_chunk->index, FIELD_STREAM);
+	unsigned long long deadlineState = chunkStream(p_chunk->index, DEADLINE_STREAM);
+	int arrivalState = initialArrivalState(&gapState);
+	double time = p_chunk->startTime;
+	struct workloadRecord record;
+	char *p_out = p_chunk->buffer;
+	for (long i = 0; i < p_chunk->count; i++)
+	{
+		generateRecord(&record, p_chunk->first + i + 1, &time, &gapState, &arrivalState, &fieldState, &deadlineState);
+		if (config.binary)
+		{
+			memcpy(p_out, &record, sizeof(record));
+			p_out += sizeof(record);
+			continue;
+		}
+		p_out = formatInt(p_out, record.id);
+		*p_out++ = '\t';
+		p_out = formatInt(p_out, record.arrivalTime);
+		*p_out++ = '\t';
+		p_out = formatInt(p_out, record.runningTime);
+		*p_out++ = '\t';
+		p_out = formatInt(p_out, record.priority);
+		*p_out++ = '\t';
+		p_out = formatInt(p_out, record.memSize);
+		if (config.deadlineSlack > 0)
+		{
+			*p_out++ = '\t';
+			p_out = formatInt(p_out, record.deadline);
+		}
+		*p_out++ = '\n';
+	}
+	p_chunk->length = p_out - p_chunk->buffer;
+	return NULL;
+}
+
+// runs the worker on up to config.threads chunks at a time and writes their buffers in order to pFile if given
+void runChunks(struct chunk *chunks, long chunkCount, void *(*worker)(void *), FILE *pFile)
+{
+	pthread_t *threads = (pthread_t *) malloc(config.threads * sizeof(pthread_t));
+	for (long first = 0; first < chunkCount; first += config.threads)
+	{
+		int round = (chunkCount - first < config.threads) ? (chunkCount - first) : config.threads;
+		for (int t = 0; t < round; t++)
+		{
+			pthread_create(&threads[t], NULL, worker, &chunks[first + t]);
+		}
+		for (int t = 0; t < round; t++)
+		{
+			pthread_join(threads[t], NULL);
+			if (pFile != NULL)
+			{
+				fwrite(chunks[first + t].buffer, 1, chunks[first + t].length, pFile);
+			}
+		}
+	}
+	free(threads);
+}
+
+// parses NAME:P1:P2:... and returns the index of NAME in names, or -1
+int parseDistribution(char *arg, char **names, int nameCount, double *params, int maxParams)
+{
+	char *copy = strdup(arg);
+	char *name = strtok(copy, ":");
+	int type = -1;
+	for (int i = 0; (name != NULL) && (i < nameCount); i++)
+	{
+		if (strcmp(name, names[i]) == 0)
+		{
+			type = i;
+		}
+	}
+	char *param;
+	for (int i = 0; (i < maxParams) && ((param = strtok(NULL, ":")) != NULL); i++)
+	{
+		params[i] = atof(param);
+	}
+	free(copy);
+	return type;
+}
+
+void buildCdf(double *cdf, double *weights, int size)
+{
+	double total = 0;
+	for (int i = 0; i < size; i++)
+	{
+		total += weights[i];
+	}
+	double sum = 0;
+	for (int i = 0; i < size; i++)
+	{
+		sum += weights[i];
+		cdf[i] = sum / total;
+	}
+	cdf[size - 1] = 1;
+}
+
+void usage()
+{
+	printf("Usage: ./test_generator.out -n COUNT [-s SEED] [-o FILE] [-b] [-j THREADS]\n");
+	printf("    [-a uniform:MIN:MAX | poisson:RATE | mmpp:RATE_LOW:RATE_HIGH:SWITCH_LOW:SWITCH_HIGH]\n");
+	printf("    [-r uniform:MIN:MAX | lognormal:MU:SIGMA | pareto:XM:ALPHA]\n");
+	printf("    [-m uniform:MIN:MAX | zipf:S[:MAX]] [-p W0,W1,...,W10] [-d SLACK]\n");
+}
+
 int main(int argc, char * argv[])
 {
-    FILE * pFile;
-    pFile = fopen("processes.txt", "w");
-    int no;
-    struct processData pData;
-    printf("Please enter the number of processes you want to generate: ");
-    scanf("%d", &no);
-    srand(time(null));
-    //fprintf(pFile,"%d\n",no);
-    fprintf(pFile, "#id arrival runtime priority memSize\n");
-    pData.arrivaltime = 1;
-    for (int i = 1 ; i <= no ; i++)
-    {
-        //generate Data Randomly
-        //[min-max] = rand() % (max_number + 1 - minimum_number) + minimum_number
-        pData.id = i;
-        pData.arrivaltime += rand() % (11); //processes arrive in order
-        pData.runningtime = rand() % (30) + 1;
-        pData.priority = rand() % (11);
-        pData.memSize = rand() % (255) + 1;
-        fprintf(pFile, "%d\t%d\t%d\t%d\t%d\n", pData.id, pData.arrivaltime, pData.runningtime, pData.priority,pData.memSize);
-    }
-    fclose(pFile);
+	// defaults: the original distributions
+	config.count = -1;
+	config.seed = time(NULL);
+	config.threads = sysconf(_SC_NPROCESSORS_ONLN);
+	config.binary = 0;
+	config.path = "processes.txt";
+	config.arrivals = UNIFORM;
+	config.arrivalParams[0] = 0;
+	config.arrivalParams[1] = 10;
+	config.runtimes = UNIFORM;
+	config.runtimeParams[0] = 1;
+	config.runtimeParams[1] = 30;
+	config.memSizes = UNIFORM;
+	config.memSizeParams[0] = 1;
+	config.memSizeParams[1] = 255;
+	config.deadlineSlack = 0;
+	double priorityWeights[MAX_PRIORITY + 1];
+	for (int i = 0; i <= MAX_PRIORITY; i++)
+	{
+		priorityWeights[i] = 1;
+	}
+
+	char *arrivalNames[] = {"uniform", "poisson", "mmpp"};
+	char *runtimeNames[] = {"uniform", "", "", "lognormal", "pareto"};
+	char *memSizeNames[] = {"uniform", "", "", "", "", "zipf"};
+	int option;
+	while ((option = getopt(argc, argv, "n:s:o:bj:a:r:m:p:d:")) != -1)
+	{
+		switch (option)
+		{
+			case 'n':
+				config.count = atol(optarg);
+				break;
+			case 's':
+				config.seed = strtoull(optarg, NULL, 10);
+				break;
+			case 'o':
+				config.path = optarg;
+				break;
+			case 'b':
+				config.binary = 1;
+				break;
+			case 'j':
+				config.threads = atoi(optarg);
+				break;
+			case 'a':
+				config.arrivals = parseDistribution(optarg, arrivalNames, 3, config.arrivalParams, 4);
+				break;
+			case 'r':
+				config.runtimes = parseDistribution(optarg, runtimeNames, 5, config.runtimeParams, 2);
+				break;
+			case 'm':
+				config.memSizeParams[1] = MAX_MEM_SIZE;
+				config.memSizes = parseDistribution(optarg, memSizeNames, 6, config.memSizeParams, 2);
+				break;
+			case 'p':
+			{
+				char *weight = strtok(optarg, ",");
+				for (int i = 0; i <= MAX_PRIORITY; i++)
+				{
+					priorityWeights[i] = (weight != NULL) ? atof(weight) : 0;
+					weight = strtok(NULL, ",");
+				}
+				break;
+			}
+			case 'd':
+				config.deadlineSlack = atof(optarg);
+				break;
+			default:
+				usage();
+				return -1;
+		}
+	}
+	if ((config.arrivals == -1) || (config.runtimes == -1) || (config.memSizes == -1) || (config.threads < 1))
+	{
+		usage();
+		return -1;
+	}
+	if (argc == 1)
+	{
+		printf("Please enter the number of processes you want to generate: ");
+		scanf("%ld", &config.count);
+	}
+	if (config.count < 0)
+	{
+		usage();
+		return -1;
+	}
+
+	// cumulative distributions of the priorities and of the Zipf memory sizes
+	buildCdf(config.priorityCdf, priorityWeights, MAX_PRIORITY + 1);
+	if (config.memSizes == ZIPF)
+	{
+		if ((config.memSizeParams[1] < 1) || (config.memSizeParams[1] > MAX_MEM_SIZE))
+		{
+			config.memSizeParams[1] = MAX_MEM_SIZE;
+		}
+		double memSizeWeights[MAX_MEM_SIZE];
+		for (int i = 0; i < config.memSizeParams[1]; i++)
+		{
+			memSizeWeights[i] = 1 / pow(i + 1, config.memSizeParams[0]);
+		}
+		buildCdf(config.memSizeCdf, memSizeWeights, config.memSizeParams[1]);
+	}
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	// split the workload in chunks
+	long chunkCount = (config.count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	struct chunk *chunks = (struct chunk *) malloc((chunkCount + 1) * sizeof(struct chunk));
+	for (long i = 0; i < chunkCount; i++)
+	{
+		chunks[i].index = i;
+		chunks[i].first = i * CHUNK_SIZE;
+		chunks[i].count = (config.count - chunks[i].first < CHUNK_SIZE) ? (config.count - chunks[i].first) : CHUNK_SIZE;
+	}
+
+	// first pass: offset each chunk by the inter-arrival times before it (processes arrive from time 1)
+	runChunks(chunks, chunkCount, measureChunk, NULL);
+	double startTime = 1;
+	for (long i = 0; i < chunkCount; i++)
+	{
+		chunks[i].startTime = startTime;
+		startTime += chunks[i].duration;
+	}
+
+	FILE *pFile = fopen(config.path, "w");
+	if (pFile == NULL)
+	{
+		printf("Could not open file %s\n", config.path);
+		return -1;
+	}
+	if (config.binary)
+	{
+		struct workloadHeader header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, WORKLOAD_MAGIC, sizeof(header.magic));
+		header.count = config.count;
+		header.hasDeadlines = (config.deadlineSlack > 0);
+		fwrite(&header, sizeof(header), 1, pFile);
+	}
+	else
+	{
+		fprintf(pFile, "#id arrival runtime priority memSize%s\n", (config.deadlineSlack > 0) ? " deadline" : "");
+	}
+
+	// second pass: one output buffer per thread, reused by the chunks of each round
+	size_t bufferSize = CHUNK_SIZE * (config.binary ? sizeof(struct workloadRecord) : MAX_LINE);
+	char **buffers = (char **) malloc(config.threads * sizeof(char *));
+	for (int t = 0; t < config.threads; t++)
+	{
+		buffers[t] = (char *) malloc(bufferSize);
+	}
+	for (long i = 0; i < chunkCount; i++)
+	{
+		chunks[i].buffer = buffers[i % config.threads];
+	}
+	runChunks(chunks, chunkCount, generateChunk, pFile);
+	fclose(pFile);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	if (argc > 1)
+	{
+		printf("Generated %ld processes in %s in %.2f s\n", config.count, config.path, (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+	}
+
+	for (int t = 0; t < config.threads; t++)
+	{
+		free(buffers[t]);
+	}
+	free(buffers);
+	free(chunks);
+	return 0;
 }
@@ -0,0 +1,105 @@
+// Chrome trace export. Scheduling and memory events are streamed to a trace-event JSON file that
+// can be opened in chrome://tracing or ui.perfetto.dev: process slices on the CPU track from
+// started/resumed to stopped/finished, instant events for allocations on the memory track, and
+// counter tracks for the ready queue depth, the waiting list depth and the free memory. Events are
+// written as they happen through a large stdio buffer, so the trace is never held in memory.
+
+// output files
+#define TRACE_LOG "trace.json"
+
+// trace time of one time step in microseconds and size of the output buffer (can be overridden with -D)
+#ifndef TRACE_TICK_US
+#define TRACE_TICK_US 1000
+#endif
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE (1 << 20)
+#endif
+
+// tracks
+#define CPU_TRACK 1
+#define MEMORY_TRACK 2
+
+struct traceExport
+{
+	FILE *pFile;
+	char *buffer;
+	long events;
+
+	// last counter values, only changes are written
+	int ready;
+	int waiting;
+	int free;
+};
+
+struct traceExport trace;
+
+// starts a new event in the JSON array
+void beginTraceEvent()
+{
+	fprintf(trace.pFile, (trace.events == 0) ? "\n" : ",\n");
+	trace.events++;
+}
+
+void initTrace()
+{
+	trace.pFile = fopen(instancePath(TRACE_LOG), "w");
+	trace.buffer = (char *) malloc(TRACE_BUFFER_SIZE);
+	setvbuf(trace.pFile, trace.buffer, _IOFBF, TRACE_BUFFER_SIZE);
+	trace.ready = -1;
+	trace.waiting = -1;
+	trace.free = -1;
+	fprintf(trace.pFile, "[");
+
+	// track names
+	beginTraceEvent();
+	fprintf(trace.pFile, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"scheduler\"}}");
+	beginTraceEvent();
+	fprintf(trace.pFile, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"CPU 0\"}}", CPU_TRACK);
+	beginTraceEvent();
+	fprintf(trace.pFile, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"memory\"}}", MEMORY_TRACK);
+}
+
+// process slices begin when a process is started or resumed and end when it is stopped or finished
+void traceProcess(int currentTime, struct PCB *p_PCB, int logType)
+{
+	char *states[] = {"started", "stopped", "finished", "resumed"};
+	bool begin = (logType == STARTED) || (logType == RESUMED);
+	beginTraceEvent();
+	fprintf(trace.pFile, "{\"name\":\"process %d\",\"ph\":\"%s\",\"ts\":%ld,\"pid\":1,\"tid\":%d,\"args\":{\"%s\":true,\"remain\":%d,\"wait\":%d}}", p_PCB->id, begin ? "B" : "E", (long) currentTime * TRACE_TICK_US, CPU_TRACK, states[logType], p_PCB->remainingTime, p_PCB->waitingTime);
+}
+
+void traceMemory(int currentTime, char *name, int processId, int bytes, int start, int end)
+{
+	beginTraceEvent();
+	fprintf(trace.pFile, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%ld,\"pid\":1,\"tid\":%d,\"args\":{\"process\":%d,\"bytes\":%d,\"start\":%d,\"end\":%d}}", name, (long) currentTime * TRACE_TICK_US, MEMORY_TRACK, processId, bytes, start, end);
+}
+
+void traceCounter(int currentTime, char *name, int *p_last, int value)
+{
+	if (value == *p_last)
+	{
+		return;
+	}
+	*p_last = value;
+	beginTraceEvent();
+	fprintf(trace.pFile, "{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%ld,\"pid\":1,\"args\":{\"value\":%d}}", name, (long) currentTime * TRACE_TICK_US, value);
+}
+
+void traceCounters(int currentTime, int ready, int waiting, int free)
+{
+	traceCounter(currentTime, "ready queue", &trace.ready, ready);
+	traceCounter(currentTime, "waiting list", &trace.waiting, waiting);
+	traceCounter(currentTime, "free memory", &trace.free, free);
+}
+
+void closeTrace()
+{
+	fprintf(trace.pFile, "\n]\n");
+	fclose(trace.pFile);
+	free(trace.buffer);
+}
+
+void writeTracePerformance(FILE *pFile)
+{
+	fprintf(pFile, "Trace events = %ld\n", trace.events);
+}
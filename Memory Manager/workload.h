@@ -0,0 +1,22 @@
+// Binary workload format written by the test generator and read by the process generator:
+// a header followed by one fixed-size record per process, in arrival order.
+
+#define WORKLOAD_MAGIC "OSWKLD1\n"
+
+struct workloadHeader
+{
+	char magic[8];
+	long count;
+	int hasDeadlines;
+	int reserved;
+};
+
+struct workloadRecord
+{
+	int id;
+	int arrivalTime;
+	int runningTime;
+	int priority;
+	int memSize;
+	int deadline;	// 0 when the workload has no deadlines
+};